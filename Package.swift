@@ -47,11 +47,12 @@ struct BSDSubModule: Module {
 
 /// The modules that are part of the package, in build order.
 let modules: [Module] = [
-    BasicModule.init(targetName: "KassHelpers", dependencies: []),
+    BasicModule.init(targetName: "KassHelpers", dependencies: ["KassC"]),
     BasicModule.init(targetName: "Linking", dependencies: []),
+    BasicModule.init(targetName: "RemoteMemory", dependencies: []),
     BasicModule.init(
         targetName: "MachCore", path: "Sources/Mach/Core",
-        dependencies: ["KassHelpers", "KassC", "Linking"]
+        dependencies: ["KassHelpers", "KassC", "Linking", "RemoteMemory"]
     ),
     MachSubModule.init(subModuleName: "Object", dependencies: []),
     BasicModule.init(
@@ -88,6 +89,20 @@ let moduleTargets =
         )
     }
 
+/// The targets that are built for development but not shipped as products.
+let developmentTargets = [
+    Target.executableTarget(
+        name: "KassBenchmarks",
+        dependencies: ["KassHelpers", "MachCore", "MachObject"],
+        path: "Sources/KassBenchmarks"
+    ),
+    Target.testTarget(
+        name: "RemoteMemoryTests",
+        dependencies: ["RemoteMemory"],
+        path: "Tests/RemoteMemoryTests"
+    ),
+]
+
 /// The products for the modules.
 let moduleProducts =
     [
@@ -110,15 +125,27 @@ let moduleProducts =
         )
     }
 
+/// The targets that do not depend on Darwin, which are the only ones built on other platforms.
+/// - Note: This lets the remote memory cache's tests run on Linux.
+let portableTargetNames: Set<String> = ["RemoteMemory", "RemoteMemoryTests"]
+
+#if canImport(Darwin)
+    let targets = moduleTargets + developmentTargets
+    let products = moduleProducts
+#else
+    let targets = (moduleTargets + developmentTargets).filter { portableTargetNames.contains($0.name) }
+    let products = moduleProducts.filter { portableTargetNames.contains($0.name) }
+#endif
+
 let package = Package(
     name: name,
     platforms: [
         .macOS(.v10_13),
         .iOS(.v12),
     ],
-    products: moduleProducts,
+    products: products,
     dependencies: [
         .package(url: "https://github.com/swiftlang/swift-docc-plugin", from: "1.4.3")
     ],
-    targets: moduleTargets
+    targets: targets
 )
@@ -0,0 +1,292 @@
+import Darwin
+import Foundation
+import MachCore
+
+// Receiving messages through a kqueue requires BSD syscalls, so we add these here instead of in the MachCore module.
+
+extension BSD {
+    /// An event loop that receives messages on many Mach ports with a single kqueue and thread.
+    /// - Note: Each port is registered with an `EVFILT_MACHPORT` filter that receives messages directly into a buffer
+    ///   for that port, so no thread blocks on any individual port.
+    /// - Note: The loop's thread runs until the loop is stopped with ``stop()``, or until waiting for events fails, in
+    ///   which case every sequence finishes with the error.
+    @available(macOS 10.15, iOS 13.0, *)
+    public final class MachPortMessageLoop: @unchecked Sendable {
+        /// A registered port.
+        private final class Registration {
+            /// The buffer the kernel receives messages for the port into.
+            let buffer: Mach.MessageBuffer
+
+            /// The continuation for the port's messages.
+            let continuation: AsyncThrowingStream<Mach.Message, any Error>.Continuation
+
+            init(buffer: Mach.MessageBuffer, continuation: AsyncThrowingStream<Mach.Message, any Error>.Continuation) {
+                self.buffer = buffer
+                self.continuation = continuation
+            }
+        }
+
+        /// The identifier of the user event used to wake the loop.
+        private static let wakeIdentifier: UInt64 = 0
+
+        /// The kqueue.
+        private let kqueue: BSD.KQueue
+
+        /// The initial size of the buffer each port receives messages into.
+        /// - Note: A port's buffer grows to fit larger messages, which stay queued until it has.
+        public let maxMessageSize: Int
+
+        /// The lock protecting the registrations.
+        private let lock = NSLock()
+
+        /// The registered ports, keyed by name.
+        private var registrations: [mach_port_name_t: Registration] = [:]
+
+        /// The ports whose registrations should be removed by the loop thread.
+        private var pendingRemovals: [mach_port_name_t] = []
+
+        /// Whether the loop has been asked to stop.
+        private var hasStopped = false
+
+        /// Creates an event loop and starts its thread.
+        public init(maxMessageSize: Int = Mach.Message.maxReceiveSize) throws {
+            self.kqueue = try BSD.KQueue()
+            self.maxMessageSize = maxMessageSize
+            try self.kqueue.event64([
+                kevent64_s(
+                    identifier: Self.wakeIdentifier, filter: .user, flags: [.add, .clear]
+                )
+            ])
+            Foundation.Thread { [self] in self.run() }.start()
+        }
+
+        /// Calls a closure while holding the lock.
+        private func synchronized<ResultType>(_ body: () throws -> ResultType) rethrows -> ResultType {
+            self.lock.lock()
+            defer { self.lock.unlock() }
+            return try body()
+        }
+
+        /// Gets the messages received on a port, which may be a port set.
+        /// - Note: Messages are only received while the sequence is being iterated, and a port can only be observed by
+        ///   one sequence at a time.
+        /// - Note: The sequence finishes with an error if receiving a message fails or the loop fails.
+        public func messages(on port: Mach.Port) throws -> AsyncThrowingStream<Mach.Message, any Error> {
+            let portName = port.name
+            var streamContinuation: AsyncThrowingStream<Mach.Message, any Error>.Continuation!
+            let stream = AsyncThrowingStream<Mach.Message, any Error> { streamContinuation = $0 }
+            let registration = Registration(
+                buffer: Mach.MessageBuffer(capacity: self.maxMessageSize),
+                continuation: streamContinuation
+            )
+            let registrationError: POSIXError? = self.synchronized {
+                guard !self.hasStopped else { return POSIXError(.ECANCELED) }
+                guard self.registrations[portName] == nil else { return POSIXError(.EBUSY) }
+                self.registrations[portName] = registration
+                return nil
+            }
+            if let registrationError { throw registrationError }
+            streamContinuation.onTermination = { [self] _ in self.unregister(portNamed: portName) }
+            do { try self.arm(registration, forPortNamed: portName) } catch {
+                self.synchronized { _ = self.registrations.removeValue(forKey: portName) }
+                throw error
+            }
+            return stream
+        }
+
+        /// Adds or updates the event that receives messages for a port into its registration's buffer.
+        private func arm(_ registration: Registration, forPortNamed portName: mach_port_name_t) throws {
+            try self.kqueue.event64([
+                kevent64_s(
+                    identifier: UInt64(portName), filter: .machPort, flags: [.add, .enable],
+                    // Messages too large for the buffer are left queued, so that the buffer can grow to fit them.
+                    filterFlags: UInt32(bitPattern: MACH_RCV_MSG | MACH_RCV_LARGE),
+                    extensions: (
+                        UInt64(UInt(bitPattern: registration.buffer.baseAddress)),
+                        UInt64(registration.buffer.capacity)
+                    )
+                )
+            ])
+        }
+
+        /// Whether the loop has been stopped.
+        public var isStopped: Bool { self.synchronized { self.hasStopped } }
+
+        /// Stops the loop.
+        /// - Note: The loop's thread finishes every sequence and exits. A stopped loop cannot be restarted.
+        public func stop() {
+            self.synchronized { self.hasStopped = true }
+            self.wake()
+        }
+
+        /// Asks the loop thread to remove the registration for a port.
+        /// - Note: The kernel may be receiving into the port's buffer, so only the loop thread can safely free it.
+        private func unregister(portNamed portName: mach_port_name_t) {
+            self.synchronized { self.pendingRemovals.append(portName) }
+            self.wake()
+        }
+
+        /// Wakes the loop thread to handle pending removals or stopping.
+        private func wake() {
+            _ = try? self.kqueue.event64([
+                kevent64_s(
+                    identifier: Self.wakeIdentifier, filter: .user, flags: [],
+                    filterFlags: UInt32(NOTE_TRIGGER)
+                )
+            ])
+        }
+
+        /// Receives events until the loop is stopped, delivering received messages to their sequences.
+        private func run() {
+            let eventCapacity = 64
+            var events = [kevent64_s](repeating: kevent64_s(), count: eventCapacity)
+            while true {
+                let eventCount: Int32
+                do {
+                    eventCount = try BSD.call(
+                        Darwin.kevent64(self.kqueue.rawValue, nil, 0, &events, Int32(eventCapacity), 0, nil)
+                    )
+                } catch POSIXError.EINTR {
+                    continue
+                } catch {
+                    // Any other error will persist, so we stop the loop rather than spin.
+                    self.synchronized { self.hasStopped = true }
+                    self.removeAllRegistrations(finishingWith: error)
+                    return
+                }
+                // Registrations are only removed after the whole batch is delivered, as a message may already have
+                // been received into the buffer of a registration that is being removed.
+                var wasWoken = false
+                for event in events.prefix(Int(eventCount)) {
+                    switch BSD.KEventFilterType(rawValue: event.filter) {
+                    case .machPort: self.deliverMessage(for: event)
+                    case .user: wasWoken = true
+                    default: break
+                    }
+                }
+                guard wasWoken else { continue }
+                if self.isStopped {
+                    self.removeAllRegistrations(finishingWith: nil)
+                    return
+                }
+                self.removePendingRegistrations()
+            }
+        }
+
+        /// Delivers the message received for an event to its sequence.
+        /// - Note: If the message is too large for the port's buffer, the buffer grows and the message is received on
+        ///   a later event. If receiving fails otherwise, the sequence finishes with the error.
+        private func deliverMessage(for event: kevent64_s) {
+            let portName = mach_port_name_t(truncatingIfNeeded: event.ident)
+            guard let registration = self.synchronized({ self.registrations[portName] }) else { return }
+            let buffer = registration.buffer
+            // The result of the receive is returned in the filter flags.
+            switch mach_msg_return_t(bitPattern: event.fflags) {
+            case MACH_MSG_SUCCESS: break
+            case MACH_RCV_TOO_LARGE:
+                // The size of the message, including its trailer, is returned in the second extension. Only this
+                // thread receives into the buffer, so it can safely grow it before the event is updated.
+                buffer.reserveCapacity(Int(clamping: event.ext.1) + MemoryLayout<mach_msg_max_trailer_t>.size)
+                do { try self.arm(registration, forPortNamed: portName) } catch {
+                    registration.continuation.finish(throwing: error)
+                }
+                return
+            case let result:
+                do { try Mach.call(result) } catch { registration.continuation.finish(throwing: error) }
+                return
+            }
+            // We only copy out as far as the trailer the kernel wrote, as the rest of the buffer may be stale.
+            let bufferView = Mach.MessageView(
+                bytes: UnsafeRawBufferPointer(start: buffer.baseAddress, count: buffer.capacity)
+            )
+            let trailerBytes = bufferView.trailerBytes
+            let messageEnd =
+                trailerBytes.isEmpty
+                ? bufferView.size : UnsafeRawPointer(buffer.baseAddress).distance(to: trailerBytes.baseAddress!)
+                    + trailerBytes.count
+            let messageView = Mach.MessageView(
+                bytes: UnsafeRawBufferPointer(start: buffer.baseAddress, count: messageEnd)
+            )
+            // If the sequence has already terminated, nobody will take ownership of the message's rights and
+            // out-of-line memory, so we destroy it.
+            if case .terminated = registration.continuation.yield(messageView.message()) {
+                mach_msg_destroy(buffer.headerPointer)
+            }
+        }
+
+        /// Removes the registrations that were asked to be removed.
+        private func removePendingRegistrations() {
+            let portNames = self.synchronized {
+                defer { self.pendingRemovals.removeAll() }
+                return self.pendingRemovals
+            }
+            for portName in portNames {
+                // The port may already be gone, in which case the kernel has already removed its event.
+                _ = try? self.kqueue.event64([
+                    kevent64_s(identifier: UInt64(portName), filter: .machPort, flags: [.delete])
+                ])
+                self.synchronized { _ = self.registrations.removeValue(forKey: portName) }
+            }
+        }
+
+        /// Removes every registration and finishes its sequence, with an error if one is passed.
+        private func removeAllRegistrations(finishingWith error: (any Error)?) {
+            let registrations = self.synchronized {
+                defer { self.registrations.removeAll() }
+                return self.registrations
+            }
+            for (portName, registration) in registrations {
+                _ = try? self.kqueue.event64([
+                    kevent64_s(identifier: UInt64(portName), filter: .machPort, flags: [.delete])
+                ])
+                registration.continuation.finish(throwing: error)
+            }
+        }
+    }
+}
+
+@available(macOS 10.15, iOS 13.0, *)
+extension BSD.MachPortMessageLoop {
+    /// The shared event loop, created on first use.
+    public static var shared: BSD.MachPortMessageLoop {
+        get throws { try SharedStorage.instance.loop() }
+    }
+
+    /// The storage for the shared event loop.
+    private final class SharedStorage: @unchecked Sendable {
+        /// The storage instance.
+        static let instance = SharedStorage()
+
+        /// The lock protecting the event loop.
+        private let lock = NSLock()
+
+        /// The event loop, if it has been created.
+        private var sharedLoop: BSD.MachPortMessageLoop?
+
+        /// Gets the event loop, creating it if needed.
+        func loop() throws -> BSD.MachPortMessageLoop {
+            self.lock.lock()
+            defer { self.lock.unlock() }
+            if let sharedLoop = self.sharedLoop, !sharedLoop.isStopped { return sharedLoop }
+            let loop = try BSD.MachPortMessageLoop()
+            self.sharedLoop = loop
+            return loop
+        }
+    }
+}
+
+@available(macOS 10.15, iOS 13.0, *)
+extension Mach.MessageServer {
+    /// The messages received by the server, delivered by the shared kqueue event loop.
+    public var messages: AsyncThrowingStream<Mach.Message, any Error> {
+        get throws { try BSD.MachPortMessageLoop.shared.messages(on: self) }
+    }
+}
+
+@available(macOS 10.15, iOS 13.0, *)
+extension Mach.PortSet {
+    /// The messages received on the ports in the port set, delivered by the shared kqueue event loop.
+    public var messages: AsyncThrowingStream<Mach.Message, any Error> {
+        get throws { try BSD.MachPortMessageLoop.shared.messages(on: self) }
+    }
+}
@@ -0,0 +1,32 @@
+import Foundation
+
+/// A benchmark that can be run from the command line.
+struct Benchmark: Sendable {
+    /// The name used to select the benchmark.
+    let name: String
+
+    /// Runs the benchmark and prints its results.
+    let run: @Sendable (_ arguments: [String]) throws -> Void
+}
+
+/// Measures the time taken by a closure, in seconds.
+func measure(_ body: () throws -> Void) rethrows -> Double {
+    let start = DispatchTime.now().uptimeNanoseconds
+    try body()
+    return Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+}
+
+/// Prints the throughput of an operation that was repeated a number of times.
+func report(_ label: String, iterations: Int, seconds: Double) {
+    let nanosecondsPerIteration = seconds * 1_000_000_000 / Double(iterations)
+    print(
+        "\(label): \(iterations) iterations in \(String(format: "%.3f", seconds)) s "
+            + "(\(String(format: "%.1f", nanosecondsPerIteration)) ns each)"
+    )
+}
+
+/// Prevents the optimizer from removing a computation whose result is otherwise unused.
+@inline(never)
+func blackHole<T>(_ value: T) {
+    withExtendedLifetime(value) {}
+}
@@ -0,0 +1,58 @@
+import Foundation
+import MachCore
+import MachObject
+
+/// An error thrown when a Mach object copied bytes that it should have viewed in place.
+struct CopiedStorageError: Error, CustomStringConvertible {
+    let description: String
+}
+
+/// Checks that mapped Mach objects view the mapped file in place, and compares mapping a file with reading it.
+/// - Note: The fixture is the first argument, or the benchmark executable itself. The check fails the benchmark if any
+///   object's bytes (including the slices of a fat binary) are not in the mapped file's storage.
+let objectMappingBenchmark = Benchmark(name: "mapping") { arguments in
+    let fixtureURL = URL(fileURLWithPath: arguments.first ?? CommandLine.arguments[0])
+
+    /// Parses the objects in a file's data, which may be a fat binary.
+    func objects(in data: Data) throws -> [any Mach.Object] {
+        if let fatBinary = try? Mach.fatBinary(validatingData: data) {
+            return try fatBinary.architectures.map { try $0.validatedObject(withFatBinary: fatBinary) }
+        }
+        return [try Mach.object(validatingData: data)]
+    }
+
+    /// The range of addresses holding a data's bytes.
+    func addressRange(of data: Data) -> Range<UInt> {
+        data.withUnsafeBytes { bytes in
+            let start = UInt(bitPattern: bytes.baseAddress)
+            return start..<start + UInt(bytes.count)
+        }
+    }
+
+    let mappedData = try Data(contentsOf: fixtureURL, options: .alwaysMapped)
+    let mappedRange = addressRange(of: mappedData)
+    let mappedObjects = try objects(in: mappedData)
+    for (index, object) in mappedObjects.enumerated() {
+        let objectRange = addressRange(of: object.data)
+        guard mappedRange.lowerBound <= objectRange.lowerBound, objectRange.upperBound <= mappedRange.upperBound
+        else { throw CopiedStorageError(description: "Object \(index) does not share the mapped file's storage.") }
+    }
+    print("\(mappedObjects.count) object(s) share the storage of the \(mappedData.count)-byte mapped file")
+
+    let iterations = 1_000
+    var mappedCount = 0
+    let mapSeconds = try measure {
+        for _ in 0..<iterations {
+            mappedCount += try objects(in: try Data(contentsOf: fixtureURL, options: .alwaysMapped)).count
+        }
+    }
+    blackHole(mappedCount)
+    report("mapped", iterations: iterations, seconds: mapSeconds)
+
+    var readCount = 0
+    let readSeconds = try measure {
+        for _ in 0..<iterations { readCount += try objects(in: try Data(contentsOf: fixtureURL)).count }
+    }
+    blackHole(readCount)
+    report("read", iterations: iterations, seconds: readSeconds)
+}
@@ -0,0 +1,59 @@
+import Foundation
+import KassHelpers
+import MachCore
+
+/// Looks up and describes option enumerations, comparing the cached lookups with a linear scan of the known cases.
+/// - Note: The linear scan is how options were looked up before the known cases were cached per type.
+let optionEnumBenchmark = Benchmark(name: "options") { _ in
+    let iterations = 1_000_000
+    let knownRawValues = Mach.PortConstructFlags.allCases.map(\.rawValue)
+    // Include a raw value with no known case, which is the worst case for a linear scan.
+    let rawValues = knownRawValues + [UInt32.max]
+
+    var scannedCount = 0
+    let scanSeconds = measure {
+        for index in 0..<iterations {
+            let rawValue = rawValues[index % rawValues.count]
+            if Mach.PortConstructFlags.allCases.first(where: { $0.rawValue == rawValue }) != nil {
+                scannedCount += 1
+            }
+        }
+    }
+    blackHole(scannedCount)
+    report("allCases.first(where:)", iterations: iterations, seconds: scanSeconds)
+
+    var namedCount = 0
+    let initSeconds = measure {
+        for index in 0..<iterations
+        where Mach.PortConstructFlags(rawValue: rawValues[index % rawValues.count]).name != nil {
+            namedCount += 1
+        }
+    }
+    blackHole(namedCount)
+    report("init(rawValue:)", iterations: iterations, seconds: initSeconds)
+
+    // Run the cached lookup from every core at once, which is where a shared lock would contend.
+    let threadCount = ProcessInfo.processInfo.activeProcessorCount
+    let concurrentSeconds = measure {
+        DispatchQueue.concurrentPerform(iterations: threadCount) { _ in
+            var namedCount = 0
+            for index in 0..<iterations
+            where Mach.PortConstructFlags(rawValue: rawValues[index % rawValues.count]).name != nil {
+                namedCount += 1
+            }
+            blackHole(namedCount)
+        }
+    }
+    report(
+        "init(rawValue:) on \(threadCount) threads", iterations: iterations * threadCount,
+        seconds: concurrentSeconds
+    )
+
+    let flags: Mach.PortConstructFlags = [.contextAsGuard, .strict, .insertSendRight]
+    var descriptionLength = 0
+    let descriptionSeconds = measure {
+        for _ in 0..<iterations / 10 { descriptionLength += flags.description.count }
+    }
+    blackHole(descriptionLength)
+    report("description", iterations: iterations / 10, seconds: descriptionSeconds)
+}
@@ -0,0 +1,52 @@
+import Foundation
+import MachCore
+import MachObject
+
+/// Symbolicates addresses against the symbol table of a 64-bit Mach object.
+/// - Note: The fixture is the first argument, or the benchmark executable itself. Fat binaries use their first 64-bit
+///   architecture.
+let symbolTableBenchmark = Benchmark(name: "symbols") { arguments in
+    let fixtureURL = URL(fileURLWithPath: arguments.first ?? CommandLine.arguments[0])
+    let fixtureData = try Data(contentsOf: fixtureURL, options: .alwaysMapped)
+    let candidates: [any Mach.Object] =
+        if let fatBinary = try? Mach.fatBinary(validatingData: fixtureData) {
+            fatBinary.objects
+        } else {
+            [try Mach.object(validatingData: fixtureData)]
+        }
+    guard let object64 = candidates.lazy.compactMap({ $0 as? Mach.Object64 }).first else {
+        throw CocoaError(.fileReadCorruptFile)
+    }
+
+    var symbolTable: Mach.SymbolTable?
+    let buildSeconds = measure { symbolTable = Mach.SymbolTable(object: object64) }
+    guard let symbolTable, let lowestAddress = symbolTable.symbols.first?.address,
+        let highestAddress = symbolTable.symbols.last?.address
+    else { throw CocoaError(.fileReadCorruptFile) }
+    print("Indexed \(symbolTable.symbols.count) symbols in \(String(format: "%.3f", buildSeconds)) s")
+
+    // Spread the addresses over the whole symbolized range with a fixed-seed generator, so runs are comparable.
+    let lookupCount = 1_000_000
+    var state: UInt64 = 0x9E37_79B9_7F4A_7C15
+    let span = max(highestAddress - lowestAddress, 1)
+    let addresses = (0..<lookupCount).map { _ in
+        state = state &* 6_364_136_223_846_793_005 &+ 1_442_695_040_888_963_407
+        return lowestAddress + (state >> 11) % span
+    }
+    var foundCount = 0
+    let addressSeconds = measure {
+        for address in addresses where symbolTable.symbol(nearestTo: address) != nil { foundCount += 1 }
+    }
+    blackHole(foundCount)
+    report("symbol(nearestTo:)", iterations: lookupCount, seconds: addressSeconds)
+
+    let names = symbolTable.symbols.map { symbolTable.name(of: $0) }
+    var nameHits = 0
+    let nameSeconds = measure {
+        for index in 0..<lookupCount where symbolTable.symbol(named: names[index % names.count]) != nil {
+            nameHits += 1
+        }
+    }
+    blackHole(nameHits)
+    report("symbol(named:)", iterations: lookupCount, seconds: nameSeconds)
+}
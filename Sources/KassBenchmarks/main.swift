@@ -0,0 +1,18 @@
+import Foundation
+
+/// The benchmarks that can be run, by name.
+let benchmarks = [symbolTableBenchmark, objectMappingBenchmark, optionEnumBenchmark]
+
+// Usage: KassBenchmarks [benchmark] [arguments...]
+// With no benchmark name, every benchmark is run with no arguments.
+let arguments = Array(CommandLine.arguments.dropFirst())
+let selectedBenchmarks =
+    arguments.first.map { name in benchmarks.filter { $0.name == name } } ?? benchmarks
+guard !selectedBenchmarks.isEmpty else {
+    print("Unknown benchmark. Available benchmarks: \(benchmarks.map(\.name).joined(separator: ", "))")
+    exit(EXIT_FAILURE)
+}
+for benchmark in selectedBenchmarks {
+    print("== \(benchmark.name) ==")
+    try benchmark.run(Array(arguments.dropFirst()))
+}
@@ -0,0 +1,17 @@
+#ifndef KASS_ATOMIC_POINTER_H
+#define KASS_ATOMIC_POINTER_H
+
+// Swift cannot use C11 atomics directly, and the standard library's atomics require newer OS versions than we
+//  support. We define functions here that load and publish a pointer with acquire and release ordering.
+
+static inline void *_Nullable kass_atomic_load_pointer(void *_Nullable const *_Nonnull location)
+{
+    return __atomic_load_n(location, __ATOMIC_ACQUIRE);
+}
+
+static inline void kass_atomic_store_pointer(void *_Nullable *_Nonnull location, void *_Nullable value)
+{
+    __atomic_store_n(location, value, __ATOMIC_RELEASE);
+}
+
+#endif /* KASS_ATOMIC_POINTER_H */
@@ -30,18 +30,94 @@ extension Namespace {
 
 extension NamedOptionEnum {
     private var singularDescription: String {
-        let className = String(describing: Self.self)
-        let caseName = "\(name ?? "unknown") (\(rawValue))"
-        return "\(className): \(caseName)"
+        var description = ""
+        self.writeSingularDescription(
+            to: &description, typeName: OptionDescriptionTable<Self>.shared.typeName
+        )
+        return description
+    }
+
+    /// Writes the description of a single option to a stream.
+    fileprivate func writeSingularDescription(
+        to stream: inout some TextOutputStream, typeName: String
+    ) {
+        stream.write(typeName)
+        stream.write(": ")
+        stream.write(name ?? "unknown")
+        stream.write(" (")
+        if let integerRawValue = rawValue as? any FixedWidthInteger {
+            writeDecimal(integerRawValue, to: &stream)
+        } else {
+            stream.write(String(describing: rawValue))
+        }
+        stream.write(")")
+    }
+}
+
+/// Writes an integer in decimal to a stream without allocating.
+/// - Note: The digits are written in chunks short enough for a `String` to store inline.
+private func writeDecimal(_ value: some FixedWidthInteger, to stream: inout some TextOutputStream) {
+    guard value.bitWidth <= 128 else {
+        stream.write(String(describing: value))
+        return
+    }
+    // A 128-bit integer has at most 39 digits, plus a sign.
+    withUnsafeTemporaryAllocation(of: UInt8.self, capacity: 40) { characters in
+        var magnitude = value.magnitude
+        var start = characters.count
+        repeat {
+            let (quotient, remainder) = magnitude.quotientAndRemainder(dividingBy: 10)
+            start -= 1
+            characters[start] = UInt8(ascii: "0") + UInt8(truncatingIfNeeded: remainder)
+            magnitude = quotient
+        } while magnitude != 0
+        if value < 0 {
+            start -= 1
+            characters[start] = UInt8(ascii: "-")
+        }
+        let maximumInlineCount = 15
+        while start < characters.count {
+            let end = min(start + maximumInlineCount, characters.count)
+            stream.write(String(decoding: UnsafeBufferPointer(rebasing: characters[start..<end]), as: UTF8.self))
+            start = end
+        }
     }
 }
 
-extension NamedOptionEnum where Self: OptionSet, Self.Element == Self {
-    public var values: [Self] { Self.allCases.filter { self.contains($0) } }
+extension NamedOptionEnum where Self: OptionSet, Self.Element == Self, RawValue: FixedWidthInteger {
+    /// The known cases contained in the option set.
+    /// - Note: This compares the bits of each known case, from a table built once per type.
+    public var values: [Self] {
+        let table = OptionSetCaseTable<Self>.shared
+        let bits = UInt64(truncatingIfNeeded: self.rawValue)
+        var values: [Self] = []
+        for (index, caseBits) in table.caseBits.enumerated() where bits & caseBits == caseBits {
+            values.append(table.cases[index])
+        }
+        return values
+    }
+
     public var description: String {
-        let className = String(describing: Self.self)
-        let caseNames = values.map { $0.singularDescription }.joined(separator: ", ")
-        return "\(className): [\(caseNames)]"
+        var description = ""
+        self.write(to: &description)
+        return description
+    }
+
+    /// Writes the description of the option set to a stream.
+    /// - Note: This walks a table of the known cases built once per type, without building intermediate arrays.
+    public func write(to stream: inout some TextOutputStream) {
+        let typeName = OptionDescriptionTable<Self>.shared.typeName
+        let table = OptionSetCaseTable<Self>.shared
+        let bits = UInt64(truncatingIfNeeded: self.rawValue)
+        stream.write(typeName)
+        stream.write(": [")
+        var isFirst = true
+        for (index, caseBits) in table.caseBits.enumerated() where bits & caseBits == caseBits {
+            if !isFirst { stream.write(", ") }
+            isFirst = false
+            table.cases[index].writeSingularDescription(to: &stream, typeName: typeName)
+        }
+        stream.write("]")
     }
 }
 
@@ -60,3 +136,15 @@ extension NamedOptionEnum {
         self = value
     }
 }
+
+extension NamedOptionEnum where RawValue: Hashable {
+    /// Represents an option with a raw value, taking one of the known cases if the raw value matches one.
+    /// - Note: The known cases are indexed by raw value the first time this is used for a type.
+    public init(rawValue: RawValue) {
+        guard let value = RawValueIndex<Self>.shared.casesByRawValue[rawValue] else {
+            self.init(name: nil, rawValue: rawValue)
+            return
+        }
+        self = value
+    }
+}
@@ -0,0 +1,131 @@
+import Foundation
+import KassC.AtomicPointer
+
+/// A cache of per-type values, built once and shared by all threads.
+/// - Note: Generic types cannot have stored static properties, so values are keyed by type instead. The cached values
+///   are published as an immutable snapshot, so lookups only load a pointer and never take a lock.
+internal enum PerTypeCache {
+    /// A key identifying a kind of value built for a type.
+    private struct Key: Hashable {
+        /// The type the value was built for.
+        let type: ObjectIdentifier
+
+        /// The kind of value.
+        let valueType: ObjectIdentifier
+    }
+
+    /// An immutable snapshot of the cached values.
+    private final class Snapshot {
+        /// The cached values.
+        let values: [Key: AnyObject]
+
+        init(values: [Key: AnyObject]) {
+            self.values = values
+        }
+    }
+
+    /// The location of the current snapshot, which is loaded with acquire ordering and published with release ordering.
+    /// - Note: Replaced snapshots are never released, as other threads may still be reading them. A snapshot is only
+    ///   replaced when a value is first built for a type, so this is bounded by the number of types used.
+    nonisolated(unsafe) private static let currentSnapshot: UnsafeMutablePointer<UnsafeMutableRawPointer?> = {
+        let location = UnsafeMutablePointer<UnsafeMutableRawPointer?>.allocate(capacity: 1)
+        location.initialize(to: Unmanaged.passRetained(Snapshot(values: [:])).toOpaque())
+        return location
+    }()
+
+    /// The lock serializing the publishing of snapshots.
+    private static let lock = NSLock()
+
+    /// Looks up a cached value in the current snapshot.
+    private static func cachedValue(for key: Key) -> AnyObject? {
+        let snapshotPointer = kass_atomic_load_pointer(Self.currentSnapshot)!
+        return Unmanaged<Snapshot>.fromOpaque(snapshotPointer)._withUnsafeGuaranteedRef { $0.values[key] }
+    }
+
+    /// Gets the cached value of a kind for a type, building it if needed.
+    internal static func value<ValueType: AnyObject>(
+        _ valueType: ValueType.Type, for type: Any.Type, build: () -> ValueType
+    ) -> ValueType {
+        let key = Key(type: ObjectIdentifier(type), valueType: ObjectIdentifier(valueType))
+        if let cachedValue = Self.cachedValue(for: key) {
+            return unsafeDowncast(cachedValue, to: ValueType.self)
+        }
+        // Building may itself use the cache (for example, through `allCases`), so we build without holding the lock.
+        // If another thread publishes a value first, we use its value so that every thread shares one.
+        let builtValue = build()
+        Self.lock.lock()
+        defer { Self.lock.unlock() }
+        if let cachedValue = Self.cachedValue(for: key) {
+            return unsafeDowncast(cachedValue, to: ValueType.self)
+        }
+        let snapshotPointer = kass_atomic_load_pointer(Self.currentSnapshot)!
+        var values = Unmanaged<Snapshot>.fromOpaque(snapshotPointer).takeUnretainedValue().values
+        values[key] = builtValue
+        kass_atomic_store_pointer(Self.currentSnapshot, Unmanaged.passRetained(Snapshot(values: values)).toOpaque())
+        return builtValue
+    }
+}
+
+/// An index of the known cases of an option by raw value.
+internal final class RawValueIndex<Option: NamedOptionEnum>: @unchecked Sendable
+where Option.RawValue: Hashable {
+    /// The known cases, keyed by raw value.
+    /// - Note: If several cases share a raw value, the first one in ``NamedOptionEnum/allCases`` is used.
+    internal let casesByRawValue: [Option.RawValue: Option]
+
+    /// Builds an index of the known cases of an option.
+    internal init() {
+        var casesByRawValue: [Option.RawValue: Option] = [:]
+        casesByRawValue.reserveCapacity(Option.allCases.count)
+        for knownCase in Option.allCases where casesByRawValue[knownCase.rawValue] == nil {
+            casesByRawValue[knownCase.rawValue] = knownCase
+        }
+        self.casesByRawValue = casesByRawValue
+    }
+
+    /// The shared index for the option.
+    internal static var shared: RawValueIndex<Option> {
+        PerTypeCache.value(Self.self, for: Option.self) { Self() }
+    }
+}
+
+/// A table of the known cases of an option and its type name, used to describe options.
+internal final class OptionDescriptionTable<Option: NamedOptionEnum>: @unchecked Sendable {
+    /// The name of the option type.
+    internal let typeName: String
+
+    /// The known cases, in the order of ``NamedOptionEnum/allCases``.
+    internal let cases: [Option]
+
+    /// Builds a description table for an option.
+    internal init() {
+        self.typeName = String(describing: Option.self)
+        self.cases = Option.allCases
+    }
+
+    /// The shared table for the option.
+    internal static var shared: OptionDescriptionTable<Option> {
+        PerTypeCache.value(Self.self, for: Option.self) { Self() }
+    }
+}
+
+/// A table of the known cases of an option set and the bits of each, used to find the cases an option set contains.
+internal final class OptionSetCaseTable<Option: NamedOptionEnum & OptionSet>: @unchecked Sendable
+where Option.RawValue: FixedWidthInteger {
+    /// The known cases, in the order of ``NamedOptionEnum/allCases``.
+    internal let cases: [Option]
+
+    /// The bits of each known case, widened so that they can be compared without generic arithmetic.
+    internal let caseBits: [UInt64]
+
+    /// Builds a case table for an option set.
+    internal init() {
+        self.cases = Option.allCases
+        self.caseBits = Option.allCases.map { UInt64(truncatingIfNeeded: $0.rawValue) }
+    }
+
+    /// The shared table for the option set.
+    internal static var shared: OptionSetCaseTable<Option> {
+        PerTypeCache.value(Self.self, for: Option.self) { Self() }
+    }
+}
@@ -0,0 +1,128 @@
+import Darwin.Mach
+import Foundation
+
+// MARK: - Message Buffer
+extension Mach {
+    /// A reusable buffer for serializing, sending and receiving messages.
+    /// - Note: The buffer grows as needed, but is never shrunk or zeroed between uses.
+    public final class MessageBuffer {
+        /// The start of the buffer.
+        public private(set) var baseAddress: UnsafeMutableRawPointer
+
+        /// The size of the buffer.
+        public private(set) var capacity: Int
+
+        /// Allocates a message buffer.
+        public init(capacity: Int = Mach.Message.maxReceiveSize) {
+            self.capacity = max(capacity, MemoryLayout<mach_msg_header_t>.size)
+            self.baseAddress = UnsafeMutableRawPointer.allocate(
+                byteCount: self.capacity, alignment: Mach.Message.alignment
+            )
+        }
+
+        deinit { self.baseAddress.deallocate() }
+
+        /// A pointer to the message header at the start of the buffer.
+        public var headerPointer: UnsafeMutablePointer<mach_msg_header_t> {
+            self.baseAddress.bindMemory(to: mach_msg_header_t.self, capacity: 1)
+        }
+
+        /// Grows the buffer to at least a given size.
+        /// - Warning: Growing the buffer invalidates any pointers into it and does not preserve its contents.
+        public func reserveCapacity(_ minimumCapacity: Int) {
+            guard minimumCapacity > self.capacity else { return }
+            self.baseAddress.deallocate()
+            // We grow geometrically so that alternating message sizes do not reallocate every time.
+            self.capacity = max(minimumCapacity, self.capacity * 2)
+            self.baseAddress = UnsafeMutableRawPointer.allocate(
+                byteCount: self.capacity, alignment: Mach.Message.alignment
+            )
+        }
+
+        /// Zeroes the part of the maximum trailer area that the kernel did not write for a received message.
+        /// - Note: The buffer is not zeroed between uses, so this keeps stale bytes out of the deserialized trailer.
+        internal func clearUnusedTrailerBytes() {
+            let messageSize = Int(self.headerPointer.pointee.msgh_size)
+            let trailerOffset = (messageSize + (Mach.Message.alignment - 1)) & ~(Mach.Message.alignment - 1)
+            let maximumTrailerEnd = trailerOffset + MemoryLayout<mach_msg_max_trailer_t>.size
+            guard trailerOffset + MemoryLayout<mach_msg_trailer_t>.size <= self.capacity else { return }
+            let trailerSize = Int(
+                self.baseAddress.load(fromByteOffset: trailerOffset, as: mach_msg_trailer_t.self)
+                    .msgh_trailer_size
+            )
+            let unusedStart = min(trailerOffset + trailerSize, self.capacity)
+            let unusedEnd = min(maximumTrailerEnd, self.capacity)
+            guard unusedStart < unusedEnd else { return }
+            (self.baseAddress + unusedStart).initializeMemory(
+                as: UInt8.self, repeating: 0, count: unusedEnd - unusedStart
+            )
+        }
+    }
+}
+
+// MARK: - Message Buffer Pool
+extension Mach {
+    /// A per-thread pool of message buffers.
+    /// - Note: Buffers are cached per thread, so taking a buffer from the pool does not take a lock.
+    public enum MessageBufferPool {
+        /// The number of buffers cached per thread.
+        public static let buffersPerThread = 4
+
+        /// The largest buffer that is returned to the pool.
+        /// - Note: Larger buffers are freed after use, so that one large message does not pin its memory.
+        public static var maximumPooledCapacity: Int { Mach.Message.maxReceiveSize * 8 }
+
+        /// The cached buffers of a thread.
+        private final class ThreadCache {
+            var buffers: [Mach.MessageBuffer] = []
+        }
+
+        /// The key for the cached buffers of the current thread.
+        private static let threadCacheKey: pthread_key_t = {
+            var key = pthread_key_t()
+            // The cache is retained by the thread, and released when the thread exits.
+            pthread_key_create(&key) { Unmanaged<AnyObject>.fromOpaque($0).release() }
+            return key
+        }()
+
+        /// The cached buffers of the current thread.
+        private static var threadCache: ThreadCache {
+            if let cachePointer = pthread_getspecific(Self.threadCacheKey) {
+                return Unmanaged<ThreadCache>.fromOpaque(cachePointer).takeUnretainedValue()
+            }
+            let cache = ThreadCache()
+            pthread_setspecific(Self.threadCacheKey, Unmanaged.passRetained(cache).toOpaque())
+            return cache
+        }
+
+        /// Calls a closure with a buffer of at least a given size from the pool.
+        /// - Warning: The buffer is returned to the pool afterwards and must not escape the closure.
+        public static func withBuffer<ResultType>(
+            minimumCapacity: Int, _ body: (Mach.MessageBuffer) throws -> ResultType
+        ) rethrows -> ResultType {
+            let cache = Self.threadCache
+            let buffer = cache.buffers.popLast() ?? Mach.MessageBuffer(capacity: minimumCapacity)
+            buffer.reserveCapacity(minimumCapacity)
+            defer {
+                if cache.buffers.count < Self.buffersPerThread,
+                    buffer.capacity <= Self.maximumPooledCapacity
+                {
+                    cache.buffers.append(buffer)
+                }
+            }
+            return try body(buffer)
+        }
+
+        /// Calls a closure with a caller-supplied buffer grown to at least a given size, or a buffer from the pool.
+        internal static func withBuffer<ResultType>(
+            _ suppliedBuffer: Mach.MessageBuffer?, minimumCapacity: Int,
+            _ body: (Mach.MessageBuffer) throws -> ResultType
+        ) rethrows -> ResultType {
+            guard let suppliedBuffer else {
+                return try Self.withBuffer(minimumCapacity: minimumCapacity, body)
+            }
+            suppliedBuffer.reserveCapacity(minimumCapacity)
+            return try body(suppliedBuffer)
+        }
+    }
+}
@@ -16,19 +16,6 @@ extension Mach.Message {
     public class var maxReceiveSize: Int {
         Int(vm_page_size) * 2  // This is somewhat arbitrary, but should be enough for most messages.
     }
-
-    /// Allocates a transient buffer for receiving messages, set to a given size.
-    fileprivate static func transientBuffer(_ size: Int?) -> UnsafeMutableRawBufferPointer {
-        let requestedSize = size ?? Self.maxReceiveSize
-        let actualSize = max(requestedSize, MemoryLayout<mach_msg_header_t>.size)  // We just go ahead and round up if needed and don't tell the user.
-        let bufferPointer = UnsafeMutableRawPointer.allocate(
-            byteCount: actualSize,
-            alignment: MemoryLayout<mach_msg_header_t>.alignment
-        )
-        let buffer = UnsafeMutableRawBufferPointer(start: bufferPointer, count: actualSize)
-        buffer.initializeMemory(as: UInt8.self, repeating: 0)
-        return buffer
-    }
 }
 
 // MARK: - Sending and Receiving
@@ -64,7 +51,8 @@ extension Mach.Message {
         to remotePort: Mach.Port? = nil,
         withDisposition remoteDisposition: Mach.PortDisposition? = nil,
         options: consuming Mach.MessageOptions = [],
-        timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
+        timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE,
+        using buffer: Mach.MessageBuffer? = nil
     ) throws {
         options.insert(.send)
         options.remove(.receive)
@@ -73,9 +61,12 @@ extension Mach.Message {
         if let remoteDispositionOverride = remoteDisposition {
             message.header.bits.remotePortDisposition = remoteDispositionOverride
         }
-        try message.withUnsafeSerializedMessage {
+        if let threshold = message.automaticOutOfLineThreshold {
+            try message.movePayloadOutOfLine(ifAtLeast: threshold)
+        }
+        try Mach.MessageBufferPool.withBuffer(buffer, minimumCapacity: message.bufferSize) {
             try Self.message(
-                $0, options: options, sendSize: message.sendSize,
+                message.serialize(into: $0), options: options, sendSize: message.sendSize,
                 receiveSize: 0, receivePort: Mach.Port.Nil, timeout: timeout,
                 notifyPort: Mach.Port.Nil
             )
@@ -97,7 +88,8 @@ extension Mach.Message {
         from receivePort: Mach.Port? = nil,
         withDisposition localDisposition: Mach.PortDisposition? = nil,
         options: consuming Mach.MessageOptions = [],
-        timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
+        timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE,
+        using buffer: Mach.MessageBuffer? = nil
     ) throws -> ReceiveMessage {
         options.insert(.send)
         options.insert(.receive)
@@ -113,21 +105,22 @@ extension Mach.Message {
         if let localDispositionOverride = localDisposition {
             message.header.bits.localPortDisposition = localDispositionOverride
         }
-        return try message.withUnsafeSerializedMessage {
-            let originalMessageBuffer = UnsafeRawBufferPointer(
-                start: $0, count: Int(message.sendSize)
-            )
-            let rawMessageBuffer = Mach.Message.transientBuffer(max(maxSize, Int(message.sendSize)))
-            defer { rawMessageBuffer.deallocate() }
-            rawMessageBuffer.copyMemory(from: originalMessageBuffer)
-            let messageBuffer = rawMessageBuffer.baseAddress!  // We control `rawMessageBuffer`, so this is safe.
-                .bindMemory(to: mach_msg_header_t.self, capacity: 1)
+        if let threshold = message.automaticOutOfLineThreshold {
+            try message.movePayloadOutOfLine(ifAtLeast: threshold)
+        }
+        // The message is serialized directly into the buffer it is received into, so it is never copied.
+        let receiveSize = max(maxSize, Int(message.sendSize))
+        return try Mach.MessageBufferPool.withBuffer(
+            buffer, minimumCapacity: max(receiveSize, message.bufferSize)
+        ) {
+            let messageBuffer = message.serialize(into: $0)
             try Self.message(
                 messageBuffer, options: options, sendSize: message.sendSize,
-                receiveSize: mach_msg_size_t(rawMessageBuffer.count),
+                receiveSize: mach_msg_size_t(receiveSize),
                 receivePort: message.header.localPort, timeout: timeout,
                 notifyPort: Mach.Port.Nil
             )
+            $0.clearUnusedTrailerBytes()
             return ReceiveMessage.init(headerPointer: messageBuffer)
         }
     }
@@ -139,22 +132,24 @@ extension Mach.Message {
         ofMaxSize maxSize: Int = ReceiveMessage.maxReceiveSize,
         from localPort: Mach.Port,
         options: consuming Mach.MessageOptions = [],
-        timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
+        timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE,
+        using buffer: Mach.MessageBuffer? = nil
     ) throws -> ReceiveMessage {
         options.remove(.send)
         options.insert(.receive)
         if timeout != MACH_MSG_TIMEOUT_NONE { options.insert(.receiveTimeout) }
-        let rawMessageBuffer = Mach.Message.transientBuffer(maxSize)
-        defer { rawMessageBuffer.deallocate() }
-        let messageBuffer = rawMessageBuffer.baseAddress!.bindMemory(
-            to: mach_msg_header_t.self, capacity: 1
-        )
-        try Self.message(
-            messageBuffer, options: options, sendSize: 0,
-            receiveSize: mach_msg_size_t(rawMessageBuffer.count), receivePort: localPort,
-            timeout: timeout,
-            notifyPort: Mach.Port.Nil
-        )
-        return ReceiveMessage.init(headerPointer: messageBuffer)
+        // We just go ahead and round up if needed and don't tell the user.
+        let receiveSize = max(maxSize, MemoryLayout<mach_msg_header_t>.size)
+        return try Mach.MessageBufferPool.withBuffer(buffer, minimumCapacity: receiveSize) {
+            let messageBuffer = $0.headerPointer
+            try Self.message(
+                messageBuffer, options: options, sendSize: 0,
+                receiveSize: mach_msg_size_t(receiveSize), receivePort: localPort,
+                timeout: timeout,
+                notifyPort: Mach.Port.Nil
+            )
+            $0.clearUnusedTrailerBytes()
+            return ReceiveMessage.init(headerPointer: messageBuffer)
+        }
     }
 }
@@ -306,33 +306,47 @@ extension Mach {
         private var index: Int = 0
 
         /// The current descriptor pointer.
-        /// - Note: Each descriptor structure can be cast as a `mach_msg_type_descriptor_t` to get the type.
-        private var pointer: UnsafePointer<mach_msg_type_descriptor_t>
-
-        /// Creates an iterator for a set of descriptor pointers.
-        init(bodyPointer: UnsafePointer<mach_msg_body_t>) {
-            self.count = Int(bodyPointer.pointee.msgh_descriptor_count)
-            self.pointer = UnsafeRawPointer(bodyPointer + 1)
-                .bindMemory(to: mach_msg_type_descriptor_t.self, capacity: 1)
+        /// - Note: Each descriptor structure can be read as a `mach_msg_type_descriptor_t` to get the type.
+        private var pointer: UnsafeRawPointer
+
+        /// Creates an iterator for a set of descriptors laid out back to back.
+        init(descriptorsPointer: UnsafeRawPointer, count: Int) {
+            self.count = count
+            self.pointer = descriptorsPointer
         }
 
         /// Deserializes a descriptor from a pointer.
         /// - Note: This has to be a separate function because the type of the descriptor is not known at compile time.
         private static func deserialize<DescriptorType: Mach.MessageDescriptor>(
             type: DescriptorType.Type,
-            fromPointer descriptorPointer: UnsafePointer<mach_msg_type_descriptor_t>
-        ) -> DescriptorType { UnsafeRawPointer(descriptorPointer).load(as: DescriptorType.self) }
+            fromPointer descriptorPointer: UnsafeRawPointer
+        ) -> DescriptorType { descriptorPointer.loadUnaligned(as: DescriptorType.self) }
+
+        /// The type of the next descriptor, or `nil` if there are no more descriptors.
+        /// - Warning: This function also returns `nil` if the type of the next descriptor is invalid.
+        fileprivate func nextType() -> Mach.MessageDescriptorType? {
+            guard self.index < self.count else { return nil }  // No more descriptors.
+            let descriptorType = Mach.MessageDescriptorType(
+                rawValue: self.pointer.loadUnaligned(as: mach_msg_type_descriptor_t.self).type
+            )
+            return descriptorType.isValid ? descriptorType : nil
+        }
+
+        /// Advances past the next descriptor and returns its size, or `nil` if there are no more descriptors.
+        /// - Warning: This function also returns `nil` if the type of the next descriptor is invalid.
+        fileprivate mutating func skip() -> Int? {
+            guard let descriptorType = self.nextType() else { return nil }
+            self.pointer += descriptorType.structType.size
+            self.index += 1
+            return descriptorType.structType.size
+        }
 
         /// Advances to the next descriptor and returns it, or `nil` if there are no more descriptors.
         /// - Warning: This function also returns `nil` if the type of the next descriptor is invalid.
         public mutating func next() -> Element? {
-            guard self.index < self.count else { return nil }  // No more descriptors.
-            let rawDescriptorType = self.pointer.pointee.type
-            let descriptorType = Mach.MessageDescriptorType(rawValue: rawDescriptorType)
-            guard descriptorType.isValid else { return nil }
+            guard let descriptorType = self.nextType() else { return nil }
             let descriptorPointer = self.pointer
-            self.pointer = (UnsafeRawPointer(self.pointer) + descriptorType.structType.size)
-                .bindMemory(to: mach_msg_type_descriptor_t.self, capacity: 1)
+            self.pointer += descriptorType.structType.size
             self.index += 1
             return Self.deserialize(type: descriptorType.structType, fromPointer: descriptorPointer)
         }
@@ -342,13 +356,33 @@ extension Mach {
 // MARK: - Body
 extension Mach {
     /// A body of message descriptors.
+    /// - Note: The descriptors are stored packed back to back, exactly as they are laid out in a message, so that
+    ///   they are not boxed individually and can be written into a message buffer in a single copy.
     public struct MessageBody {
+        /// The raw bytes of the descriptors.
+        private var descriptorBytes: [UInt8]
+
+        /// The number of descriptors in the body.
+        public private(set) var descriptorCount: Int
+
         /// The descriptors in the body.
-        public let descriptors: [any Mach.MessageDescriptor]
+        /// - Note: The descriptors are unpacked each time this is accessed.
+        public var descriptors: [any Mach.MessageDescriptor] {
+            self.descriptorBytes.withUnsafeBytes { descriptorBytes in
+                guard let baseAddress = descriptorBytes.baseAddress else { return [] }
+                var descriptors: [any Mach.MessageDescriptor] = []
+                descriptors.reserveCapacity(self.descriptorCount)
+                var iterator = Mach.MessageDescriptorIterator(
+                    descriptorsPointer: baseAddress, count: self.descriptorCount
+                )
+                while let descriptor = iterator.next() { descriptors.append(descriptor) }
+                return descriptors
+            }
+        }
 
         /// The total size of the body in bytes.
         internal var totalSize: Int {
-            MemoryLayout<mach_msg_body_t>.size + self.descriptors.reduce(0) { $0 + $1.size }
+            MemoryLayout<mach_msg_body_t>.size + self.descriptorBytes.count
         }
 
         /// Allocates a buffer for the body, copies the count and descriptors into it, and returns a pointer to the buffer.
@@ -358,48 +392,102 @@ extension Mach {
                 byteCount: self.totalSize,
                 alignment: MemoryLayout<mach_msg_body_t>.alignment
             )
-            startPointer.initializeMemory(as: UInt8.self, repeating: 0, count: self.totalSize)
-            let bodyPointer = startPointer.bindMemory(to: mach_msg_body_t.self, capacity: 1)
-            bodyPointer.pointee.msgh_descriptor_count = mach_msg_size_t(self.descriptors.count)
-            var descriptorPointer = startPointer + MemoryLayout<mach_msg_body_t>.size
-            for descriptor in self.descriptors {
-                withUnsafeBytes(of: descriptor) { descriptorBytes in
-                    // If we defined `descriptors` correctly, this should never happen, but we'll check anyway.
-                    guard let baseAddress = descriptorBytes.baseAddress
-                    else { fatalError("Descriptor pointer is nil.") }
-
-                    // If we defined `size` correctly, this should never happen, but we'll check anyway.
-                    guard descriptor.size == descriptorBytes.count
-                    else { fatalError("Descriptor size mismatch.") }
-
-                    // If we defined `size` and `totalSize` correctly, this should never happen, but we'll check anyway.
-                    guard (descriptorPointer + descriptor.size) <= (startPointer + self.totalSize)
-                    else { fatalError("Descriptor overflow.") }
-
-                    // Now that we've checked everything, we can safely copy the descriptor.
-                    descriptorPointer.copyMemory(
-                        from: baseAddress, byteCount: descriptorBytes.count
-                    )
-
-                    // Finally, we advance the pointer.
-                    descriptorPointer += descriptor.size
-                }
-            }
+            self.serialize(to: startPointer)
             return UnsafePointer(startPointer.bindMemory(to: mach_msg_body_t.self, capacity: 1))
         }
 
+        /// Writes the count and descriptors into a buffer of at least ``totalSize`` bytes.
+        internal func serialize(to startPointer: UnsafeMutableRawPointer) {
+            startPointer.storeBytes(
+                of: mach_msg_body_t(msgh_descriptor_count: mach_msg_size_t(self.descriptorCount)),
+                as: mach_msg_body_t.self
+            )
+            self.descriptorBytes.withUnsafeBytes {
+                guard let baseAddress = $0.baseAddress else { return }
+                (startPointer + MemoryLayout<mach_msg_body_t>.size).copyMemory(
+                    from: baseAddress, byteCount: $0.count
+                )
+            }
+        }
+
+        /// Creates an empty message body.
+        public init() {
+            self.descriptorBytes = []
+            self.descriptorCount = 0
+        }
+
         /// Creates a new message body with a list of descriptors.
         public init(descriptors: [any Mach.MessageDescriptor]) {
-            self.descriptors = descriptors
+            self.init()
+            for descriptor in descriptors { self.append(descriptor) }
+        }
+
+        /// Creates a new message body with a list of descriptors of the same type.
+        /// - Note: The descriptors are copied into the body in a single pass, without being boxed.
+        public init<DescriptorType: Mach.MessageDescriptor>(packing descriptors: [DescriptorType]) {
+            self.descriptorBytes = descriptors.withUnsafeBytes {
+                // Descriptors are packed, so there must not be any padding between them.
+                precondition(MemoryLayout<DescriptorType>.stride == DescriptorType.size, "Descriptor has padding.")
+                return Array($0)
+            }
+            self.descriptorCount = descriptors.count
         }
 
         /// Represents an existing body.
         /// - Warning: The resulting body may be invalid if any of the descriptors are not valid.
         public init(fromPointer: UnsafePointer<mach_msg_body_t>) {
-            var descriptors: [any Mach.MessageDescriptor] = []
-            var iterator = Mach.MessageDescriptorIterator(bodyPointer: fromPointer)
-            while let descriptor = iterator.next() { descriptors.append(descriptor) }
-            self.descriptors = descriptors
+            let descriptorsPointer = UnsafeRawPointer(fromPointer + 1)
+            var iterator = Mach.MessageDescriptorIterator(
+                descriptorsPointer: descriptorsPointer,
+                count: Int(fromPointer.pointee.msgh_descriptor_count)
+            )
+            var descriptorCount = 0
+            var descriptorsSize = 0
+            while let descriptorSize = iterator.skip() {
+                descriptorCount += 1
+                descriptorsSize += descriptorSize
+            }
+            self.descriptorBytes = Array(
+                UnsafeRawBufferPointer(start: descriptorsPointer, count: descriptorsSize)
+            )
+            self.descriptorCount = descriptorCount
+        }
+
+        /// Appends a descriptor to the body.
+        public mutating func append<DescriptorType: Mach.MessageDescriptor>(_ descriptor: DescriptorType) {
+            withUnsafeBytes(of: descriptor) { descriptorBytes in
+                // If we defined `size` correctly, this should never happen, but we'll check anyway.
+                guard descriptor.size == descriptorBytes.count
+                else { fatalError("Descriptor size mismatch.") }
+                self.descriptorBytes.append(contentsOf: descriptorBytes)
+            }
+            self.descriptorCount += 1
+        }
+
+        /// Removes the last descriptor from the body and returns it, if it has a given type.
+        /// - Note: The descriptors before it are skipped by their types, without being unpacked.
+        public mutating func removeLastDescriptor<DescriptorType: Mach.MessageDescriptor>(
+            ofType descriptorType: Mach.MessageDescriptorType, as _: DescriptorType.Type = DescriptorType.self
+        ) -> DescriptorType? {
+            guard self.descriptorCount > 0 else { return nil }
+            let lastDescriptor: (offset: Int, descriptor: DescriptorType)? = self.descriptorBytes.withUnsafeBytes {
+                guard let baseAddress = $0.baseAddress else { return nil }
+                var iterator = Mach.MessageDescriptorIterator(
+                    descriptorsPointer: baseAddress, count: self.descriptorCount
+                )
+                var offset = 0
+                for _ in 1..<self.descriptorCount {
+                    guard let descriptorSize = iterator.skip() else { return nil }
+                    offset += descriptorSize
+                }
+                guard iterator.nextType() == descriptorType, $0.count - offset == DescriptorType.size
+                else { return nil }
+                return (offset, $0.loadUnaligned(fromByteOffset: offset, as: DescriptorType.self))
+            }
+            guard let lastDescriptor else { return nil }
+            self.descriptorBytes.removeSubrange(lastDescriptor.offset...)
+            self.descriptorCount -= 1
+            return lastDescriptor.descriptor
         }
     }
 }
@@ -28,7 +28,8 @@ extension Mach {
             replyPort: Mach.Port? = nil,
             serverErrorDomain: String? = nil,
             additionalOptions: Mach.MessageOptions = [],
-            timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
+            timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE,
+            using buffer: Mach.MessageBuffer? = nil
         ) throws -> MIGReply<Never> {
             try self.doRoutine(
                 routineIndex,
@@ -37,7 +38,8 @@ extension Mach {
                 replyPort: replyPort,
                 serverErrorDomain: serverErrorDomain,
                 additionalOptions: additionalOptions,
-                timeout: timeout
+                timeout: timeout,
+                using: buffer
             )
         }
 
@@ -53,7 +55,8 @@ extension Mach {
             replyPort: Mach.Port? = nil,
             serverErrorDomain: String? = nil,
             additionalOptions: Mach.MessageOptions = [],
-            timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
+            timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE,
+            using buffer: Mach.MessageBuffer? = nil
         ) throws -> ReplyMessage {
             let routineID = self.baseRoutineID + routineIndex
             request.header.msgh_id = routineID
@@ -64,56 +67,10 @@ extension Mach {
                 receiving: ReplyMessage.self, ofMaxSize: maxReplySize,
                 // We make a send-once right so we can receive the reply.
                 from: replyPort ?? Mach.MIGReplyPort(), withDisposition: .makeSendOnce,
-                options: additionalOptions, timeout: timeout
+                options: additionalOptions, timeout: timeout, using: buffer
             )
 
-            // The below checks are made by client code generated by the MIG compiler, so we make them too.
-
-            guard reply.header.msgh_id != MACH_NOTIFY_SEND_ONCE else {
-                // The server deallocated the send-once right without using it, assume it died.
-                throw Mach.MIGError(.serverDied)
-            }
-            guard reply.header.msgh_id == routineID + 100 else {
-                // The reply ID should be the request ID + 100.
-                throw Mach.MIGError(.replyMismatch)
-            }
-            guard reply.header.remotePort == Mach.Port.Nil else {
-                // The reply should clear the remote port.
-                throw Mach.MIGError(.typeError)
-            }
-
-            // If the reply is not complex and the same size as a MIG reply error, we
-            // assume it is a reply error and parse it as such.
-            if !reply.header.bits.isMessageComplex
-                && reply.header.msgh_size == MemoryLayout<mig_reply_error_t>.size
-            {
-                try reply.withUnsafeSerializedMessage {
-                    try $0.withMemoryRebound(to: mig_reply_error_t.self, capacity: 1) {
-                        let replyError = $0.pointee
-                        // The name "reply error" is actually a bit of a misnomer. If the return code
-                        // is `KERN_SUCCESS`, there was no error. We return early in this case.
-                        if replyError.RetCode == KERN_SUCCESS { return }
-
-                        // If the return code is a MIG error code, we throw a MIG error.
-                        if let matchingMIGErrorCode = Mach.MIGErrorCode.allCases
-                            .first(where: { $0.rawValue == replyError.RetCode })
-                        {
-                            // The `noReply` case is not actually an error, just the absence of
-                            // a defined reply. We return early as if there was no error.
-                            if matchingMIGErrorCode == .noReply { return }
-
-                            // Otherwise, we throw a MIG error.
-                            throw Mach.MIGError(matchingMIGErrorCode)
-                        }
-
-                        // If it's not a MIG error code, we throw a generic error with (if available)
-                        // the user-provided error domain.
-                        throw NSError(
-                            domain: serverErrorDomain ?? "", code: Int(replyError.RetCode)
-                        )
-                    }
-                }
-            }
+            try Self.validate(reply: reply, routineID: routineID, serverErrorDomain: serverErrorDomain)
             return reply
         }
     }
@@ -126,3 +83,56 @@ extension Mach.ClientInitializableByServiceName where Self: Mach.MIGClient {
         self.baseRoutineID = baseRoutineID
     }
 }
+
+extension Mach.MIGClient {
+    /// Checks a reply to a MIG routine, throwing an error if it is invalid or reports an error.
+    internal static func validate(
+        reply: Mach.Message, routineID: mach_msg_id_t, serverErrorDomain: String?
+    ) throws {
+        // The below checks are made by client code generated by the MIG compiler, so we make them too.
+
+        guard reply.header.msgh_id != MACH_NOTIFY_SEND_ONCE else {
+            // The server deallocated the send-once right without using it, assume it died.
+            throw Mach.MIGError(.serverDied)
+        }
+        guard reply.header.msgh_id == routineID + 100 else {
+            // The reply ID should be the request ID + 100.
+            throw Mach.MIGError(.replyMismatch)
+        }
+        guard reply.header.remotePort == Mach.Port.Nil else {
+            // The reply should clear the remote port.
+            throw Mach.MIGError(.typeError)
+        }
+
+        // If the reply is not complex and the same size as a MIG reply error, we
+        // assume it is a reply error and parse it as such.
+        guard
+            !reply.header.bits.isMessageComplex
+                && reply.header.msgh_size == MemoryLayout<mig_reply_error_t>.size
+        else { return }
+
+        // The return code follows the NDR record in the payload, so we read it from there rather than
+        // serializing the whole reply again.
+        guard let returnCode = reply.replyErrorReturnCode else { throw Mach.MIGError(.typeError) }
+
+        // The name "reply error" is actually a bit of a misnomer. If the return code
+        // is `KERN_SUCCESS`, there was no error. We return early in this case.
+        if returnCode == KERN_SUCCESS { return }
+
+        // If the return code is a MIG error code, we throw a MIG error.
+        if let matchingMIGErrorCode = Mach.MIGErrorCode.allCases
+            .first(where: { $0.rawValue == returnCode })
+        {
+            // The `noReply` case is not actually an error, just the absence of
+            // a defined reply. We return early as if there was no error.
+            if matchingMIGErrorCode == .noReply { return }
+
+            // Otherwise, we throw a MIG error.
+            throw Mach.MIGError(matchingMIGErrorCode)
+        }
+
+        // If it's not a MIG error code, we throw a generic error with (if available)
+        // the user-provided error domain.
+        throw NSError(domain: serverErrorDomain ?? "", code: Int(returnCode))
+    }
+}
@@ -1,3 +1,6 @@
+import Darwin.Mach
+import Foundation
+
 extension Mach {
     /// A MIG reply message.
     open class MIGReply<MIGPayloadType: Mach.MIGPayload>: Mach.Message,
@@ -6,3 +9,15 @@ extension Mach {
         public typealias PayloadType = MIGPayloadType
     }
 }
+
+extension Mach.Message {
+    /// The return code of the message, if it has the layout of a MIG reply error.
+    /// - Note: A MIG reply error is not complex, and its payload is an NDR record followed by a return code.
+    internal var replyErrorReturnCode: kern_return_t? {
+        let returnCodeOffset = MemoryLayout<NDR_record_t>.size
+        guard !self.header.bits.isMessageComplex, let payload = self.payload,
+            payload.count == returnCodeOffset + MemoryLayout<kern_return_t>.size
+        else { return nil }
+        return payload.withUnsafeBytes { $0.loadUnaligned(fromByteOffset: returnCodeOffset, as: kern_return_t.self) }
+    }
+}
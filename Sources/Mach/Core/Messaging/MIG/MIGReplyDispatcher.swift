@@ -0,0 +1,352 @@
+import Darwin.Mach
+import Foundation
+
+extension Mach {
+    /// A dispatcher for replies to MIG routines performed asynchronously.
+    /// - Note: The dispatcher keeps a pool of reply ports in a port set. A single thread receives on the port set and
+    ///   completes the routine waiting on the reply port each reply arrives on, so any number of routines can be in
+    ///   flight without blocking a thread each.
+    /// - Important: The receiving thread keeps the dispatcher alive until it is stopped with ``stop()``.
+    public final class MIGReplyDispatcher: @unchecked Sendable {
+        /// A handler for the reply to a pending routine.
+        /// - Note: This is passed the reply, or an error if the routine was cancelled.
+        fileprivate typealias ReplyHandler = (Result<Mach.MessageView, any Error>) -> Void
+
+        /// The port set containing the reply ports.
+        public let portSet: Mach.PortSet
+
+        /// The maximum size of a reply.
+        public let maxReplySize: Int
+
+        /// The maximum number of idle reply ports kept for reuse.
+        public let maximumIdleReplyPorts: Int
+
+        /// The lock protecting the reply ports and pending routines.
+        private let lock = NSLock()
+
+        /// The reply ports not in use by a pending routine.
+        private var idleReplyPorts: [Mach.Port] = []
+
+        /// A pending routine.
+        private struct PendingRoutine {
+            /// The registration of the routine, distinguishing it from other routines that used the same reply port.
+            let registration: UInt64
+
+            /// The handler for the reply to the routine.
+            let replyHandler: ReplyHandler
+        }
+
+        /// The pending routines, keyed by reply port name.
+        private var pendingRoutines: [mach_port_name_t: PendingRoutine] = [:]
+
+        /// The registration of the next pending routine.
+        private var nextRegistration: UInt64 = 0
+
+        /// Whether the receiving thread has been started.
+        private var isReceiving = false
+
+        /// Whether the dispatcher has been asked to stop.
+        private var hasStopped = false
+
+        /// The port in the port set used to wake the receiving thread when the dispatcher is stopped.
+        private let wakePort: Mach.Port
+
+        /// Creates a reply dispatcher with a new port set.
+        public init(
+            maxReplySize: Int = Mach.Message.maxReceiveSize, maximumIdleReplyPorts: Int = 16
+        ) throws {
+            let portSet = try Mach.PortSet.allocate(right: .portSet)
+            do {
+                let wakePort = try Mach.Port.allocate(right: .receive)
+                do { try wakePort.insert(into: portSet) } catch {
+                    try? wakePort.userRefs(for: .receive) -= 1
+                    throw error
+                }
+                self.wakePort = wakePort
+            } catch {
+                try? portSet.userRefs(for: .portSet) -= 1
+                throw error
+            }
+            self.portSet = portSet
+            self.maxReplySize = maxReplySize
+            self.maximumIdleReplyPorts = maximumIdleReplyPorts
+        }
+
+        /// Calls a closure while holding the lock.
+        private func synchronized<ResultType>(_ body: () throws -> ResultType) rethrows -> ResultType {
+            self.lock.lock()
+            defer { self.lock.unlock() }
+            return try body()
+        }
+
+        /// Takes an idle reply port, or allocates a new one in the port set.
+        fileprivate func takeReplyPort() throws -> Mach.Port {
+            let idleReplyPort: Mach.Port? = try self.synchronized {
+                guard !self.hasStopped else { throw POSIXError(.ECANCELED) }
+                return self.idleReplyPorts.popLast()
+            }
+            if let replyPort = idleReplyPort { return replyPort }
+            let replyPort = try Mach.Port.allocate(right: .receive)
+            try replyPort.insert(into: self.portSet)
+            return replyPort
+        }
+
+        /// Returns a reply port to the pool once it has no pending routine.
+        private func recycle(_ replyPort: Mach.Port) {
+            let shouldKeep = self.synchronized {
+                guard !self.hasStopped, self.idleReplyPorts.count < self.maximumIdleReplyPorts else { return false }
+                self.idleReplyPorts.append(replyPort)
+                return true
+            }
+            if !shouldKeep { Self.retire(replyPort) }
+        }
+
+        /// Destroys the receive right of a reply port that will not be reused.
+        private static func retire(_ replyPort: Mach.Port) {
+            try? replyPort.userRefs(for: .receive) -= 1
+        }
+
+        /// Registers the handler for the reply to a routine, starting the receiving thread if needed, and returns the
+        /// registration of the routine.
+        /// - Note: If the dispatcher has been stopped, the reply port is retired, the handler is passed an error and
+        ///   `nil` is returned.
+        fileprivate func register(_ replyHandler: @escaping ReplyHandler, for replyPort: Mach.Port) -> UInt64? {
+            let registrationState: (registration: UInt64, shouldStartReceiving: Bool)? = self.synchronized {
+                guard !self.hasStopped else { return nil }
+                let registration = self.nextRegistration
+                self.nextRegistration += 1
+                self.pendingRoutines[replyPort.name] = PendingRoutine(
+                    registration: registration, replyHandler: replyHandler
+                )
+                let wasReceiving = self.isReceiving
+                self.isReceiving = true
+                return (registration, !wasReceiving)
+            }
+            guard let registrationState else {
+                Self.retire(replyPort)
+                replyHandler(.failure(POSIXError(.ECANCELED)))
+                return nil
+            }
+            if registrationState.shouldStartReceiving {
+                Foundation.Thread { [self] in self.receiveReplies() }.start()
+            }
+            return registrationState.registration
+        }
+
+        /// Whether the dispatcher has been stopped.
+        public var isStopped: Bool { self.synchronized { self.hasStopped } }
+
+        /// Stops the dispatcher.
+        /// - Note: Pending routines fail with `ECANCELED`, as do routines performed afterwards. The receiving thread is
+        ///   woken up and exits, destroying the port set. A stopped dispatcher cannot be restarted.
+        public func stop() {
+            var pendingRoutines: [mach_port_name_t: PendingRoutine] = [:]
+            var idleReplyPorts: [Mach.Port] = []
+            let wasReceiving: Bool? = self.synchronized {
+                guard !self.hasStopped else { return nil }
+                self.hasStopped = true
+                swap(&pendingRoutines, &self.pendingRoutines)
+                swap(&idleReplyPorts, &self.idleReplyPorts)
+                return self.isReceiving
+            }
+            guard let wasReceiving else { return }
+            for replyPort in idleReplyPorts { Self.retire(replyPort) }
+            for (replyPortName, pendingRoutine) in pendingRoutines {
+                Self.retire(Mach.Port(named: replyPortName))
+                pendingRoutine.replyHandler(.failure(POSIXError(.ECANCELED)))
+            }
+            guard wasReceiving else {
+                self.destroyPortSet()
+                return
+            }
+            // An empty message on the wake port wakes up the receiving thread, which destroys the port set on its way
+            // out. The wake port's queue holds nothing else, so the message cannot time out.
+            _ = try? Mach.Message.send(
+                Mach.Message(), to: self.wakePort, withDisposition: .makeSend, options: [.sendTimeout], timeout: 0
+            )
+        }
+
+        /// Destroys the wake port and the port set once the dispatcher is stopped.
+        private func destroyPortSet() {
+            Self.retire(self.wakePort)
+            try? self.portSet.userRefs(for: .portSet) -= 1
+        }
+
+        /// Takes the handler for the reply to a pending routine, if the routine is still pending.
+        /// - Note: If a registration is passed, the handler is only taken if it belongs to that routine.
+        private func takeReplyHandler(
+            forReplyPortNamed replyPortName: mach_port_name_t, registration: UInt64? = nil
+        ) -> ReplyHandler? {
+            self.synchronized {
+                guard let pendingRoutine = self.pendingRoutines[replyPortName],
+                    registration == nil || pendingRoutine.registration == registration
+                else { return nil }
+                self.pendingRoutines[replyPortName] = nil
+                return pendingRoutine.replyHandler
+            }
+        }
+
+        /// Cancels a pending routine, if it is still pending.
+        /// - Note: The reply port is retired rather than reused, as the reply may still arrive on it.
+        fileprivate func cancel(
+            replyPortNamed replyPortName: mach_port_name_t, registration: UInt64? = nil, with error: any Error
+        ) {
+            guard let replyHandler = self.takeReplyHandler(forReplyPortNamed: replyPortName, registration: registration)
+            else { return }
+            Self.retire(Mach.Port(named: replyPortName))
+            replyHandler(.failure(error))
+        }
+
+        /// Receives replies until the dispatcher is stopped, completing the pending routine for each.
+        private func receiveReplies() {
+            let buffer = Mach.MessageBuffer(capacity: self.maxReplySize)
+            let receiveOptions: Mach.MessageOptions = [.receive, .receiveLarge]
+            var consecutiveFailureCount = 0
+            while true {
+                let result = mach_msg(
+                    buffer.headerPointer, receiveOptions.rawValue, 0, mach_msg_size_t(buffer.capacity),
+                    self.portSet.name, MACH_MSG_TIMEOUT_NONE, mach_port_name_t(MACH_PORT_NULL)
+                )
+                if self.isStopped {
+                    // Any reply received here has no pending routine left, so it is destroyed.
+                    if result == MACH_MSG_SUCCESS { mach_msg_destroy(buffer.headerPointer) }
+                    self.destroyPortSet()
+                    return
+                }
+                switch result {
+                case MACH_MSG_SUCCESS:
+                    consecutiveFailureCount = 0
+                    guard buffer.headerPointer.pointee.msgh_local_port != self.wakePort.name else {
+                        mach_msg_destroy(buffer.headerPointer)
+                        continue
+                    }
+                    buffer.clearUnusedTrailerBytes()
+                    self.dispatchReply(in: buffer)
+                case MACH_RCV_TOO_LARGE:
+                    // The reply is left queued, and its size is in the header. We grow the buffer to receive it, so
+                    // that it reaches its routine (as an error, if it is larger than the maximum reply size).
+                    buffer.reserveCapacity(
+                        Int(buffer.headerPointer.pointee.msgh_size) + MemoryLayout<mach_msg_max_trailer_t>.size
+                    )
+                default:
+                    // Errors here cannot be attributed to a routine, so we back off rather than spin if they persist.
+                    consecutiveFailureCount += 1
+                    usleep(useconds_t(1_000 << min(consecutiveFailureCount, 10)))
+                }
+            }
+        }
+
+        /// Completes the pending routine for a reply received into a buffer.
+        /// - Note: Replies larger than the maximum reply size, or with no pending routine, are destroyed.
+        private func dispatchReply(in buffer: Mach.MessageBuffer) {
+            let reply = Mach.MessageView(headerPointer: buffer.headerPointer, bufferSize: buffer.capacity)
+            let replyPortName = reply.header.msgh_local_port
+            guard let replyHandler = self.takeReplyHandler(forReplyPortNamed: replyPortName) else {
+                mach_msg_destroy(buffer.headerPointer)
+                return
+            }
+            guard Int(reply.header.msgh_size) <= self.maxReplySize else {
+                mach_msg_destroy(buffer.headerPointer)
+                // This is the error the reply would have been received with without `MACH_RCV_LARGE`.
+                replyHandler(.failure(NSError(domain: NSMachErrorDomain, code: Int(MACH_RCV_TOO_LARGE))))
+                self.recycle(Mach.Port(named: replyPortName))
+                return
+            }
+            replyHandler(.success(reply))
+            self.recycle(Mach.Port(named: replyPortName))
+        }
+    }
+}
+
+extension Mach.MIGReplyDispatcher {
+    /// The shared reply dispatcher, created on first use.
+    public static var shared: Mach.MIGReplyDispatcher {
+        get throws { try SharedStorage.instance.dispatcher() }
+    }
+
+    /// The storage for the shared reply dispatcher.
+    private final class SharedStorage: @unchecked Sendable {
+        /// The storage instance.
+        static let instance = SharedStorage()
+
+        /// The lock protecting the dispatcher.
+        private let lock = NSLock()
+
+        /// The dispatcher, if it has been created.
+        private var sharedDispatcher: Mach.MIGReplyDispatcher?
+
+        /// Gets the dispatcher, creating it if needed.
+        func dispatcher() throws -> Mach.MIGReplyDispatcher {
+            self.lock.lock()
+            defer { self.lock.unlock() }
+            if let sharedDispatcher = self.sharedDispatcher, !sharedDispatcher.isStopped { return sharedDispatcher }
+            let dispatcher = try Mach.MIGReplyDispatcher()
+            self.sharedDispatcher = dispatcher
+            return dispatcher
+        }
+    }
+}
+
+@available(macOS 10.15, iOS 13.0, *)
+extension Mach.MIGClient {
+    /// Performs a MIG routine asynchronously, receiving the reply through a reply dispatcher.
+    /// - Note: The calling thread is not blocked waiting for the reply, so many routines can be in flight at once.
+    /// - Note: The timeout applies to both sending the request and waiting for the reply.
+    @discardableResult
+    public func doRoutine<
+        ReplyPayload: Mach.MIGPayload, ReplyMessage: Mach.MIGReply<ReplyPayload>
+    >(
+        _ routineIndex: mach_msg_id_t,
+        request: Mach.MIGRequest<some Mach.MIGPayload>,
+        replyPayloadType: ReplyPayload.Type = ReplyPayload.self,
+        dispatchingRepliesWith replyDispatcher: Mach.MIGReplyDispatcher,
+        serverErrorDomain: String? = nil,
+        additionalOptions: Mach.MessageOptions = [],
+        timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
+    ) async throws -> ReplyMessage {
+        let routineID = self.baseRoutineID + routineIndex
+        request.header.msgh_id = routineID
+        let replyPort = try replyDispatcher.takeReplyPort()
+        let replyPortName = replyPort.name
+        // We make a send-once right so we can receive the reply.
+        request.header.localPort = replyPort
+        request.header.bits.localPortDisposition = .makeSendOnce
+
+        let reply: ReplyMessage = try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { continuation in
+                guard
+                    let registration = replyDispatcher.register(
+                        { result in continuation.resume(with: result.map { $0.message(as: ReplyMessage.self) }) },
+                        for: replyPort
+                    )
+                else { return }
+                guard !Task.isCancelled else {
+                    replyDispatcher.cancel(replyPortNamed: replyPortName, with: CancellationError())
+                    return
+                }
+                if timeout != MACH_MSG_TIMEOUT_NONE {
+                    // The timeout also applies to waiting for the reply, which fails as a timed-out receive would.
+                    DispatchQueue.global().asyncAfter(deadline: .now() + .milliseconds(Int(timeout))) {
+                        replyDispatcher.cancel(
+                            replyPortNamed: replyPortName, registration: registration,
+                            with: NSError(domain: NSMachErrorDomain, code: Int(MACH_RCV_TIMED_OUT))
+                        )
+                    }
+                }
+                do {
+                    try Mach.Message.send(
+                        request,
+                        // We make a copy of the send right so we can reuse the port.
+                        to: self, withDisposition: .copySend,
+                        options: additionalOptions, timeout: timeout
+                    )
+                } catch { replyDispatcher.cancel(replyPortNamed: replyPortName, with: error) }
+            }
+        } onCancel: {
+            replyDispatcher.cancel(replyPortNamed: replyPortName, with: CancellationError())
+        }
+
+        try Self.validate(reply: reply, routineID: routineID, serverErrorDomain: serverErrorDomain)
+        return reply
+    }
+}
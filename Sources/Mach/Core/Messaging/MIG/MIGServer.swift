@@ -11,7 +11,8 @@ extension Mach {
     /// A handler for a MIG server routine.
     public struct MIGServerRoutineHandler {
         /// The handler with untyped messages.
-        let untypedHandler: (Mach.Message) throws -> Mach.Message
+        /// - Note: The request is read and deserialized directly from the receive buffer, without being copied.
+        let untypedHandler: (Mach.MessageView) throws -> Mach.Message
 
         /// Initializes a new routine handler.
         public init<RequestPayload: Mach.MIGPayload, ReplyPayload: Mach.MIGPayload>(
@@ -21,23 +22,37 @@ extension Mach {
             _ typedHandler:
                 @escaping (Mach.MIGRequest<RequestPayload>) throws -> Mach.MIGReply<ReplyPayload>
         ) {
+            // We compare descriptor types by identity so that we don't need to decode any descriptors.
+            let expectedDescriptorTypeIDs = expectingDescriptorTypes?.map { ObjectIdentifier($0) }
             self.untypedHandler = { incomingMessage in
-                let typedMessage = incomingMessage.withUnsafeSerializedMessage {
-                    Mach.MIGRequest<RequestPayload>.init(headerPointer: $0)
+                /// Whether the descriptors are of the expected types.
+                func descriptorsAreExpected() -> Bool {
+                    // If the message has no body, we need to check if that's what we were expecting.
+                    guard incomingMessage.header.bits.isMessageComplex else {
+                        return expectedDescriptorTypeIDs == nil
+                    }
+                    var descriptorTypes = incomingMessage.descriptors.makeIterator()
+                    var index = 0
+                    while let descriptorType = descriptorTypes.nextType() {
+                        guard let expectedDescriptorTypeIDs, index < expectedDescriptorTypeIDs.count,
+                            ObjectIdentifier(descriptorType.structType) == expectedDescriptorTypeIDs[index]
+                        else { return false }
+                        index += 1
+                    }
+                    return true
                 }
+
+                guard descriptorsAreExpected() else {
+                    // If the descriptors are unexpected, we tell the client that their arguments were invalid.
+                    return Mach.MIGReply(
+                        typedPayload: Mach.MIGErrorReplyPayload(returnCode: MIG_BAD_ARGUMENTS)
+                    )
+                }
+                let typedMessage = incomingMessage.decodedMessage(as: Mach.MIGRequest<RequestPayload>.self)
                 guard
                     // If the payload type is not Never, it should have been recovered
-                    //  from the above initializer. If it is Never, it should be nil.
+                    //  from the above conversion. If it is Never, it should be nil.
                     ((RequestPayload.self != Never.self) == (typedMessage.typedPayload != nil))
-                        // We need to check if the descriptors are of the expected types.
-                        && (typedMessage.body?.descriptors.enumerated()
-                            .allSatisfy {
-                                index, descriptor in
-                                type(of: descriptor) == expectingDescriptorTypes?[index]
-                            }
-                            // If we're short-circuiting here, there were no descriptors, so we
-                            //  now need to check if that's what we were expecting.
-                            ?? (expectingDescriptorTypes == nil))
                         // We need to check if the additional predicate is satisfied.
                         && ((expectingAdditionalPredicate?(typedMessage) ?? true) == true)
 
@@ -82,7 +97,7 @@ extension Mach {
         }
 
         /// Gets the reply for an incoming message.
-        private func getReplyFor(incomingMessage: Mach.Message) -> Mach.Message {
+        private func getReplyFor(incomingMessage: Mach.MessageView) -> Mach.Message {
             let routineIndex = incomingMessage.header.msgh_id - self.baseRoutineID
             guard
                 self.routinesHandlers.indices.contains(Int(routineIndex)),
@@ -102,17 +117,15 @@ extension Mach {
             }
         }
 
-        /// Replies to an incoming message.
-        private func replyTo(incomingMessage: Mach.Message) throws {
+        /// Gets the reply for an incoming message, addressed to the sender of the message.
+        internal func replyMessage(for incomingMessage: Mach.MessageView) -> Mach.Message {
             let replyMessage = self.getReplyFor(incomingMessage: incomingMessage)
             replyMessage.header.msgh_id = incomingMessage.header.msgh_id + 100
-            try Mach.Message.send(
-                replyMessage,
-                // We send the reply message to the port that sent the request.
-                to: incomingMessage.header.remotePort,
-                // We move back our send-once right to the sender.
-                withDisposition: .moveSendOnce
-            )
+            // We send the reply message to the port that sent the request.
+            replyMessage.header.remotePort = incomingMessage.header.remotePort
+            // We move back our send-once right to the sender.
+            replyMessage.header.bits.remotePortDisposition = .moveSendOnce
+            return replyMessage
         }
 
         /// A thread that listens for incoming messages and replies to them.
@@ -138,13 +151,9 @@ extension Mach {
 
             /// Listens for incoming messages and replies to them.
             override func main() {
-                while true {
-                    do {
-                        let incomingMessage =
-                            try Mach.Message.receive(from: server, options: receiveOptions)
-                        try server.replyTo(incomingMessage: incomingMessage)
-                    } catch { errorHandler?(error) }
-                }
+                Mach.MIGServer.serveRequests(
+                    on: server, receiveOptions: receiveOptions, errorHandler: errorHandler
+                ) { server.replyMessage(for: $0) }
             }
         }
 
@@ -166,6 +175,80 @@ extension Mach {
     }
 }
 
+extension Mach.MIGServer {
+    /// Serves requests forever, sending each reply and receiving the next request in a single `mach_msg` call.
+    /// - Note: Like `mach_msg_server`, this alternates between two buffers. The reply is serialized into one while the
+    ///   request is still in the other, and the next request is received into the buffer the reply was sent from.
+    /// - Note: If the closure returns `nil`, no reply is sent and the request is destroyed, releasing its rights and
+    ///   out-of-line memory. If the reply carries `MIG_NO_REPLY`, neither is done, as the routine kept the request.
+    ///   If it carries any other error, the request is destroyed before the reply is sent.
+    /// - Note: Serving stops once a request is received after `isStopped` returns `true`. That request is destroyed.
+    internal static func serveRequests(
+        on receivePort: Mach.Port, receiveOptions: Mach.MessageOptions,
+        errorHandler: ((Error) -> Void)?,
+        until isStopped: () -> Bool = { false },
+        _ replyMessage: (Mach.MessageView) -> Mach.Message?
+    ) {
+        let receiveSize = Mach.Message.maxReceiveSize
+        var requestBuffer = Mach.MessageBuffer(capacity: receiveSize)
+        var replyBuffer = Mach.MessageBuffer(capacity: receiveSize)
+        var receiveOnlyOptions = receiveOptions
+        receiveOnlyOptions.remove(.send)
+        receiveOnlyOptions.insert(.receive)
+        let sendAndReceiveOptions = receiveOnlyOptions.union(.send)
+        var hasRequest = false
+        while true {
+            do {
+                // We only receive on its own for the first request, or after a failed call.
+                if !hasRequest {
+                    try Mach.Message.message(
+                        requestBuffer.headerPointer, options: receiveOnlyOptions, sendSize: 0,
+                        receiveSize: mach_msg_size_t(receiveSize), receivePort: receivePort
+                    )
+                    hasRequest = true
+                }
+                guard !isStopped() else {
+                    mach_msg_destroy(requestBuffer.headerPointer)
+                    return
+                }
+                requestBuffer.clearUnusedTrailerBytes()
+                let request = Mach.MessageView(
+                    bytes: UnsafeRawBufferPointer(start: requestBuffer.baseAddress, count: receiveSize)
+                )
+                let reply = replyMessage(request)
+                hasRequest = false
+                guard let reply else {
+                    mach_msg_destroy(requestBuffer.headerPointer)
+                    continue
+                }
+                let returnCode = reply.replyErrorReturnCode
+                // The routine kept the request, including its reply port, and will reply to it later.
+                if returnCode == MIG_NO_REPLY { continue }
+                if let returnCode, returnCode != KERN_SUCCESS {
+                    // Like `mach_msg_server`, we destroy a failed request, except for the reply port we reply on.
+                    requestBuffer.headerPointer.pointee.msgh_remote_port = mach_port_name_t(MACH_PORT_NULL)
+                    mach_msg_destroy(requestBuffer.headerPointer)
+                }
+                replyBuffer.reserveCapacity(max(receiveSize, reply.bufferSize))
+                let replyHeaderPointer = reply.serialize(into: replyBuffer)
+                let result = mach_msg(
+                    replyHeaderPointer, sendAndReceiveOptions.rawValue, reply.sendSize,
+                    mach_msg_size_t(receiveSize), receivePort.name, MACH_MSG_TIMEOUT_NONE,
+                    mach_port_name_t(MACH_PORT_NULL)
+                )
+                if result == MACH_SEND_INVALID_DEST || result == MACH_SEND_TIMED_OUT {
+                    // The reply was returned to us unsent, so we destroy it to release its moved send-once right and
+                    // any descriptors.
+                    mach_msg_destroy(replyHeaderPointer)
+                }
+                try Mach.call(result)
+                swap(&requestBuffer, &replyBuffer)
+                hasRequest = true
+            } catch { errorHandler?(error) }
+        }
+    }
+}
+
 extension Mach.ServerInitializableByServiceName where Self: Mach.MIGServer {
     /// Registers a MIG server for the given service name.
     public init(serviceName: String, baseRoutineID: mach_msg_id_t) throws {
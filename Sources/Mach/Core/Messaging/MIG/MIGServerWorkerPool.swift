@@ -0,0 +1,224 @@
+import Darwin.Mach
+import Foundation
+
+extension Mach {
+    /// Statistics for a MIG server routine.
+    public struct MIGRoutineStatistics: Sendable {
+        /// The number of requests handled.
+        public internal(set) var requestCount: UInt64 = 0
+
+        /// The total time spent handling requests, in nanoseconds.
+        public internal(set) var totalLatency: UInt64 = 0
+
+        /// The longest time spent handling a request, in nanoseconds.
+        public internal(set) var maximumLatency: UInt64 = 0
+
+        /// The average time spent handling a request, in nanoseconds.
+        public var averageLatency: UInt64 { self.requestCount == 0 ? 0 : self.totalLatency / self.requestCount }
+    }
+
+    /// A pool of threads that serve MIG requests concurrently.
+    /// - Note: Threads are started on demand. Whenever every thread is busy handling a request, another thread is
+    ///   started to keep receiving, up to the maximum. Each thread handles one request at a time, so the maximum
+    ///   thread count also caps the number of handlers in flight.
+    /// - Note: The threads run until the pool is stopped with ``stop()``.
+    public final class MIGServerWorkerPool: @unchecked Sendable {
+        /// The servers the pool handles requests for.
+        public let servers: [Mach.MIGServer]
+
+        /// The port the pool receives requests on.
+        /// - Note: This is either the only server, or a port set containing all of the servers.
+        public let receivePort: Mach.Port
+
+        /// The maximum number of threads, and thus of handlers in flight.
+        public let maximumThreadCount: Int
+
+        /// The options for receiving messages.
+        private let receiveOptions: Mach.MessageOptions
+
+        /// The error handler to call on errors.
+        private let errorHandler: ((Error) -> Void)?
+
+        /// The lock protecting the counters.
+        private let lock = NSLock()
+
+        /// The number of threads started.
+        private var startedThreadCount = 0
+
+        /// The number of threads waiting for a request.
+        private var idleThreadCount = 0
+
+        /// The number of requests being handled.
+        private var inFlightHandlerCount = 0
+
+        /// Whether the pool has been stopped.
+        private var isStopped = false
+
+        /// The statistics for each routine, keyed by message ID.
+        private var statisticsByMessageID: [mach_msg_id_t: Mach.MIGRoutineStatistics] = [:]
+
+        /// Creates a worker pool for a server.
+        public init(
+            server: Mach.MIGServer,
+            maximumThreadCount: Int = ProcessInfo.processInfo.activeProcessorCount,
+            receiveOptions: Mach.MessageOptions = [],
+            errorHandler: ((Error) -> Void)? = nil
+        ) {
+            self.servers = [server]
+            self.receivePort = server
+            self.maximumThreadCount = max(1, maximumThreadCount)
+            self.receiveOptions = receiveOptions
+            self.errorHandler = errorHandler
+        }
+
+        /// Creates a worker pool for several servers, moving them into a port set.
+        /// - Note: Requests are dispatched to the server whose port they were received on.
+        public init(
+            servers: [Mach.MIGServer], portSet: Mach.PortSet,
+            maximumThreadCount: Int = ProcessInfo.processInfo.activeProcessorCount,
+            receiveOptions: Mach.MessageOptions = [],
+            errorHandler: ((Error) -> Void)? = nil
+        ) throws {
+            for server in servers { try server.move(to: portSet) }
+            self.servers = servers
+            self.receivePort = portSet
+            self.maximumThreadCount = max(1, maximumThreadCount)
+            self.receiveOptions = receiveOptions
+            self.errorHandler = errorHandler
+        }
+
+        /// Starts receiving requests.
+        /// - Important: Errors passed to the handler may originate in either
+        ///      the receiving of a message or the sending of a reply.
+        /// - Note: A stopped pool cannot be started again.
+        public func start(initialThreadCount: Int = 1) {
+            let threadsToStart: Int = self.synchronized {
+                guard !self.isStopped else { return 0 }
+                let count = max(0, min(initialThreadCount, self.maximumThreadCount - self.startedThreadCount))
+                self.startedThreadCount += count
+                self.idleThreadCount += count
+                return count
+            }
+            for _ in 0..<threadsToStart { self.startThread() }
+        }
+
+        /// Stops the pool.
+        /// - Note: Idle threads are woken up and exit, and busy threads exit once they have replied to their current
+        ///   request. Requests received after the pool is stopped are destroyed without a reply.
+        public func stop() {
+            let threadsToWake: Int = self.synchronized {
+                guard !self.isStopped else { return 0 }
+                self.isStopped = true
+                return self.startedThreadCount
+            }
+            guard let wakePort = self.servers.first else { return }
+            for _ in 0..<threadsToWake {
+                // An empty message wakes up a receiving thread. If the queue is full, the queued requests wake up the
+                // threads instead, so there is no need to keep trying.
+                guard
+                    (try? Mach.Message.send(
+                        Mach.Message(), to: wakePort, withDisposition: .makeSend, options: [.sendTimeout],
+                        timeout: 0
+                    )) != nil
+                else { break }
+            }
+        }
+
+        /// The number of threads started.
+        public var threadCount: Int { self.synchronized { self.startedThreadCount } }
+
+        /// The number of requests being handled.
+        public var inFlightHandlers: Int { self.synchronized { self.inFlightHandlerCount } }
+
+        /// The statistics for each routine, keyed by request message ID.
+        public var statistics: [mach_msg_id_t: Mach.MIGRoutineStatistics] {
+            self.synchronized { self.statisticsByMessageID }
+        }
+
+        /// The number of requests queued on the servers' ports and not yet received.
+        public var queueDepth: Int {
+            get throws {
+                try self.servers.reduce(0) { $0 + Int(try $1.attributes.status.mps_msgcount) }
+            }
+        }
+
+        /// Calls a closure while holding the lock.
+        private func synchronized<ResultType>(_ body: () throws -> ResultType) rethrows -> ResultType {
+            self.lock.lock()
+            defer { self.lock.unlock() }
+            return try body()
+        }
+
+        /// Starts a worker thread.
+        /// - Note: The thread must already be counted as started and idle.
+        private func startThread() {
+            let thread = Foundation.Thread { [self] in
+                Mach.MIGServer.serveRequests(
+                    on: self.receivePort, receiveOptions: self.receiveOptions,
+                    errorHandler: self.errorHandler, until: { self.synchronized { self.isStopped } }
+                ) { self.handle($0) }
+                // The thread stops between requests, so it is counted as idle.
+                self.synchronized {
+                    self.startedThreadCount -= 1
+                    self.idleThreadCount -= 1
+                }
+            }
+            thread.start()
+        }
+
+        /// Handles a received request and returns its reply, starting another thread first if no other thread is
+        /// receiving.
+        private func handle(_ request: Mach.MessageView) -> Mach.Message? {
+            let shouldStartThread: Bool = self.synchronized {
+                self.idleThreadCount -= 1
+                self.inFlightHandlerCount += 1
+                guard !self.isStopped, self.idleThreadCount == 0, self.startedThreadCount < self.maximumThreadCount
+                else {
+                    return false
+                }
+                self.startedThreadCount += 1
+                self.idleThreadCount += 1
+                return true
+            }
+            if shouldStartThread { self.startThread() }
+
+            let startTime = DispatchTime.now().uptimeNanoseconds
+            let localPortName = request.header.msgh_local_port
+            let server =
+                self.servers.count == 1
+                ? self.servers.first : self.servers.first(where: { $0.name == localPortName })
+            // If no server matches, no reply is sent and the request is destroyed.
+            let reply = server?.replyMessage(for: request)
+            let latency = DispatchTime.now().uptimeNanoseconds - startTime
+
+            self.synchronized {
+                self.idleThreadCount += 1
+                self.inFlightHandlerCount -= 1
+                var routineStatistics = self.statisticsByMessageID[request.id, default: .init()]
+                routineStatistics.requestCount += 1
+                routineStatistics.totalLatency += latency
+                routineStatistics.maximumLatency = max(routineStatistics.maximumLatency, latency)
+                self.statisticsByMessageID[request.id] = routineStatistics
+            }
+            return reply
+        }
+    }
+}
+
+extension Mach.MIGServer {
+    /// Starts listening for incoming messages on a pool of threads and returns the pool.
+    /// - Important: Errors passed to the handler may originate in either
+    ///      the receiving of a message or the sending of a reply.
+    public func startListening(
+        maximumThreadCount: Int,
+        _ errorHandler: ((Error) -> Void)? = nil,
+        receiveOptions: Mach.MessageOptions = []
+    ) -> Mach.MIGServerWorkerPool {
+        let workerPool = Mach.MIGServerWorkerPool(
+            server: self, maximumThreadCount: maximumThreadCount,
+            receiveOptions: receiveOptions, errorHandler: errorHandler
+        )
+        workerPool.start()
+        return workerPool
+    }
+}
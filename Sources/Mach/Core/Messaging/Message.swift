@@ -20,6 +20,14 @@ extension Mach {
         /// The message trailer.
         public var trailer: mach_msg_max_trailer_t?
 
+        /// The payload size at or above which the payload is moved out of line when the message is sent, or `nil` to
+        /// always send the payload inline.
+        /// - Note: See ``movePayloadOutOfLine(ifAtLeast:)``.
+        public var automaticOutOfLineThreshold: Int?
+
+        /// The memory the out-of-line payload descriptor refers to, which is kept alive with the message.
+        internal var outOfLinePayloadStorage: NSData?
+
         /// The size of the message body.
         internal var bodySize: Int { body?.totalSize ?? 0 }
 
@@ -33,28 +41,32 @@ extension Mach {
 
         /// The size of the message buffer.
         internal var bufferSize: Int {
-            MemoryLayout<mach_msg_header_t>.size
-                + self.bodySize
-                + self.payloadSize
-                + MemoryLayout<mach_msg_max_trailer_t>.size
+            Int(self.sendSize) + MemoryLayout<mach_msg_max_trailer_t>.size
         }
 
         /// Allocates a message buffer, serializes it with the message contents, and returns a header pointer.
         /// - Warning: Deallocation is the responsibility of the caller.
         public func serialize() -> UnsafeMutablePointer<mach_msg_header_t> {
-            // Allocate the buffer.
             let startPointer = UnsafeMutableRawPointer.allocate(
                 byteCount: self.bufferSize, alignment: Self.alignment
             )
+            return self.serialize(to: startPointer)
+        }
+
+        /// Serializes the message into a reusable buffer, growing it if needed, and returns a header pointer.
+        /// - Warning: The header pointer is only valid until the buffer is reused or grown.
+        public func serialize(into buffer: Mach.MessageBuffer) -> UnsafeMutablePointer<mach_msg_header_t> {
+            buffer.reserveCapacity(self.bufferSize)
+            return self.serialize(to: buffer.baseAddress)
+        }
 
+        /// Serializes the message into a buffer of at least ``bufferSize`` bytes and returns a header pointer.
+        private func serialize(
+            to startPointer: UnsafeMutableRawPointer
+        ) -> UnsafeMutablePointer<mach_msg_header_t> {
             // Create a mutable pointer to advance through the buffer.
             var serializingPointer = startPointer
 
-            // Zero out the buffer.
-            serializingPointer.initializeMemory(
-                as: UInt8.self, repeating: 0, count: self.bufferSize
-            )
-
             // Write the header.
             let headerPointer = serializingPointer.bindMemory(
                 to: mach_msg_header_t.self, capacity: 1
@@ -65,15 +77,7 @@ extension Mach {
 
             // Write the body, if it exists.
             if let ownBody = self.body {
-                let bodyPointer = serializingPointer.bindMemory(
-                    to: mach_msg_body_t.self, capacity: 1
-                )
-                ownBody.withUnsafeSerializedBody {
-                    UnsafeMutableRawPointer(bodyPointer).copyMemory(
-                        from: $0,
-                        byteCount: ownBody.totalSize
-                    )
-                }
+                ownBody.serialize(to: serializingPointer)
                 serializingPointer += ownBody.totalSize
             }
 
@@ -98,6 +102,13 @@ extension Mach {
                 headerPointer.pointee.msgh_size = mach_msg_size_t(payloadEndPointer - startPointer)
             }
 
+            // Zero out the alignment padding and the trailer, as the buffer may be reused. Everything before them has
+            // already been written.
+            serializingPointer.initializeMemory(
+                as: UInt8.self, repeating: 0,
+                count: startPointer + self.bufferSize - serializingPointer
+            )
+
             // Realign the pointer after writing an arbitrarily-sized payload.
             serializingPointer = serializingPointer.alignedUp(toMultipleOf: Self.alignment)
 
@@ -163,11 +174,12 @@ extension Mach {
 
 extension Mach.Message {
     /// Serializes the message and provides a pointer to it in a handler.
+    /// - Note: The message is serialized into a buffer from ``Mach/MessageBufferPool``.
     public func withUnsafeSerializedMessage<T>(
         _ body: (UnsafeMutablePointer<mach_msg_header_t>) throws -> T
     ) rethrows -> T {
-        let headerPointer = self.serialize()
-        defer { headerPointer.deallocate() }
-        return try body(headerPointer)
+        try Mach.MessageBufferPool.withBuffer(minimumCapacity: self.bufferSize) {
+            try body(self.serialize(into: $0))
+        }
     }
 }
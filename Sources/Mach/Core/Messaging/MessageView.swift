@@ -0,0 +1,259 @@
+import Darwin.Mach
+import Foundation
+
+// MARK: - Message View
+extension Mach {
+    /// A non-owning view of a serialized message, such as a message in a receive buffer.
+    /// - Note: Reading the header, descriptors or a trivial payload through the view does not allocate or copy the
+    ///   message. Use ``message(as:)`` to get an owned copy.
+    /// - Warning: The view does not own its memory, so it is only valid for as long as the buffer it views.
+    public struct MessageView {
+        /// The bytes of the serialized message, including any trailer.
+        public let bytes: UnsafeRawBufferPointer
+
+        /// Represents a serialized message in a buffer.
+        public init(bytes: UnsafeRawBufferPointer) {
+            self.bytes = bytes
+        }
+
+        /// Represents a serialized message at a header pointer, in a buffer of a given size.
+        public init(headerPointer: UnsafePointer<mach_msg_header_t>, bufferSize: Int) {
+            self.bytes = UnsafeRawBufferPointer(start: headerPointer, count: bufferSize)
+        }
+
+        /// Whether the buffer is large enough to hold a message header.
+        private var hasHeader: Bool { self.bytes.count >= MemoryLayout<mach_msg_header_t>.size }
+
+        /// The message header.
+        /// - Note: This is zeroed if the buffer is too small to hold a header.
+        public var header: mach_msg_header_t {
+            guard self.hasHeader else { return mach_msg_header_t() }
+            return self.bytes.loadUnaligned(as: mach_msg_header_t.self)
+        }
+
+        /// The message ID.
+        public var id: mach_msg_id_t { self.header.msgh_id }
+
+        /// The size of the message as advertised in the header, clamped to the buffer.
+        public var size: Int { min(Int(self.header.msgh_size), self.bytes.count) }
+
+        /// The offset of the message body, if the message is complex.
+        private var bodyOffset: Int? {
+            guard self.header.bits.isMessageComplex,
+                MemoryLayout<mach_msg_header_t>.size + MemoryLayout<mach_msg_body_t>.size <= self.size
+            else { return nil }
+            return MemoryLayout<mach_msg_header_t>.size
+        }
+
+        /// The number of descriptors in the message body.
+        public var descriptorCount: Int {
+            guard let bodyOffset = self.bodyOffset else { return 0 }
+            return Int(
+                self.bytes.loadUnaligned(fromByteOffset: bodyOffset, as: mach_msg_body_t.self)
+                    .msgh_descriptor_count
+            )
+        }
+
+        /// The descriptors in the message body.
+        /// - Note: The descriptors are decoded lazily as the sequence is iterated.
+        public var descriptors: Descriptors {
+            guard let bodyOffset = self.bodyOffset else {
+                return Descriptors(bytes: UnsafeRawBufferPointer(start: nil, count: 0), count: 0)
+            }
+            let descriptorsStart = bodyOffset + MemoryLayout<mach_msg_body_t>.size
+            return Descriptors(
+                bytes: UnsafeRawBufferPointer(rebasing: self.bytes[descriptorsStart..<self.size]),
+                count: self.descriptorCount
+            )
+        }
+
+        /// The offset of the payload in the message.
+        private var payloadOffset: Int {
+            guard let bodyOffset = self.bodyOffset else {
+                return min(MemoryLayout<mach_msg_header_t>.size, self.size)
+            }
+            let descriptors = self.descriptors
+            return bodyOffset + MemoryLayout<mach_msg_body_t>.size + descriptors.totalSize
+        }
+
+        /// The raw bytes of the message payload.
+        public var payloadBytes: UnsafeRawBufferPointer {
+            let payloadOffset = self.payloadOffset
+            guard payloadOffset < self.size else { return UnsafeRawBufferPointer(start: nil, count: 0) }
+            return UnsafeRawBufferPointer(rebasing: self.bytes[payloadOffset..<self.size])
+        }
+
+        /// Loads the payload as a trivial payload type.
+        /// - Note: Returns `nil` if the payload is not exactly the size of the payload type.
+        public func payload<PayloadType: Mach.TrivialMessagePayload>(
+            as payloadType: PayloadType.Type = PayloadType.self
+        ) -> PayloadType? {
+            let payloadBytes = self.payloadBytes
+            guard payloadBytes.count == MemoryLayout<PayloadType>.size else { return nil }
+            return payloadBytes.loadUnaligned(as: PayloadType.self)
+        }
+
+        /// The raw bytes of the kernel-appended trailer, if the buffer contains one.
+        public var trailerBytes: UnsafeRawBufferPointer {
+            let trailerOffset = (self.size + (Mach.Message.alignment - 1)) & ~(Mach.Message.alignment - 1)
+            guard trailerOffset + MemoryLayout<mach_msg_trailer_t>.size <= self.bytes.count else {
+                return UnsafeRawBufferPointer(start: nil, count: 0)
+            }
+            let trailerSize = Int(
+                self.bytes.loadUnaligned(fromByteOffset: trailerOffset, as: mach_msg_trailer_t.self)
+                    .msgh_trailer_size
+            )
+            let trailerEnd = min(trailerOffset + trailerSize, self.bytes.count)
+            return UnsafeRawBufferPointer(rebasing: self.bytes[trailerOffset..<trailerEnd])
+        }
+
+        /// Copies the viewed message into an owned message.
+        /// - Note: Only the message and room for a maximum-size trailer are copied, not the rest of the buffer.
+        public func message<MessageType: Mach.Message>(
+            as messageType: MessageType.Type = Mach.Message.self
+        ) -> MessageType {
+            // Messages deserialize a maximum-size trailer, so we copy into a buffer large enough for one.
+            let alignedSize = (self.size + (Mach.Message.alignment - 1)) & ~(Mach.Message.alignment - 1)
+            let bufferSize = alignedSize + MemoryLayout<mach_msg_max_trailer_t>.size
+            return Mach.MessageBufferPool.withBuffer(minimumCapacity: bufferSize) { buffer in
+                let copiedCount = min(self.bytes.count, bufferSize)
+                if let sourceAddress = self.bytes.baseAddress {
+                    buffer.baseAddress.copyMemory(from: sourceAddress, byteCount: copiedCount)
+                }
+                (buffer.baseAddress + copiedCount).initializeMemory(
+                    as: UInt8.self, repeating: 0, count: bufferSize - copiedCount
+                )
+                // The size in the header may exceed the viewed bytes, but the copy must not be read past them.
+                if self.hasHeader, Int(buffer.headerPointer.pointee.msgh_size) > self.size {
+                    buffer.headerPointer.pointee.msgh_size = mach_msg_size_t(self.size)
+                }
+                return MessageType(headerPointer: buffer.headerPointer)
+            }
+        }
+
+        /// Deserializes the viewed message straight from the viewed bytes, copying it only if that is not possible.
+        /// - Important: The trailer area must already be cleared, as it is for a receive buffer after
+        ///   ``MessageBuffer/clearUnusedTrailerBytes()``.
+        internal func decodedMessage<MessageType: Mach.Message>(
+            as messageType: MessageType.Type = Mach.Message.self
+        ) -> MessageType {
+            let alignedSize = (self.size + (Mach.Message.alignment - 1)) & ~(Mach.Message.alignment - 1)
+            // Messages deserialize a maximum-size trailer, so the viewed bytes must have room for one.
+            guard Int(self.header.msgh_size) == self.size,
+                alignedSize + MemoryLayout<mach_msg_max_trailer_t>.size <= self.bytes.count,
+                let baseAddress = self.bytes.baseAddress,
+                Int(bitPattern: baseAddress) % Mach.Message.alignment == 0
+            else { return self.message(as: messageType) }
+            let headerPointer = baseAddress.assumingMemoryBound(to: mach_msg_header_t.self)
+            return MessageType(headerPointer: UnsafeMutablePointer(mutating: headerPointer))
+        }
+    }
+}
+
+// MARK: - Descriptors
+extension Mach.MessageView {
+    /// A lazily-decoded sequence of the descriptors in a message body.
+    public struct Descriptors: Sequence {
+        /// The bytes of the descriptors.
+        fileprivate let bytes: UnsafeRawBufferPointer
+
+        /// The advertised number of descriptors.
+        public let count: Int
+
+        /// An iterator over the descriptors.
+        /// - Note: Iteration stops early if a descriptor type is invalid or a descriptor extends past the message.
+        public struct Iterator: IteratorProtocol {
+            /// The bytes of the descriptors.
+            fileprivate let bytes: UnsafeRawBufferPointer
+
+            /// The number of descriptors left to decode.
+            fileprivate var remainingCount: Int
+
+            /// The offset of the next descriptor.
+            public fileprivate(set) var offset = 0
+
+            /// Decodes the next descriptor.
+            public mutating func next() -> (any Mach.MessageDescriptor)? {
+                guard let descriptorType = self.nextDescriptorType else { return nil }
+                let descriptor = Self.load(descriptorType.structType, from: self.bytes, at: self.offset)
+                self.offset += descriptorType.structType.size
+                self.remainingCount -= 1
+                return descriptor
+            }
+
+            /// Advances past the next descriptor and returns its type, without decoding it.
+            public mutating func nextType() -> Mach.MessageDescriptorType? {
+                guard let descriptorType = self.nextDescriptorType else { return nil }
+                self.offset += descriptorType.structType.size
+                self.remainingCount -= 1
+                return descriptorType
+            }
+
+            /// The type of the next descriptor, if there is a valid one.
+            fileprivate var nextDescriptorType: Mach.MessageDescriptorType? {
+                guard self.remainingCount > 0,
+                    self.offset + MemoryLayout<mach_msg_type_descriptor_t>.size <= self.bytes.count
+                else { return nil }
+                let descriptorType = Mach.MessageDescriptorType(
+                    rawValue: self.bytes.loadUnaligned(
+                        fromByteOffset: self.offset, as: mach_msg_type_descriptor_t.self
+                    ).type
+                )
+                guard descriptorType.isValid,
+                    self.offset + descriptorType.structType.size <= self.bytes.count
+                else { return nil }
+                return descriptorType
+            }
+
+            /// Loads a descriptor of a type known only at runtime.
+            private static func load<DescriptorType: Mach.MessageDescriptor>(
+                _ type: DescriptorType.Type, from bytes: UnsafeRawBufferPointer, at offset: Int
+            ) -> DescriptorType {
+                bytes.loadUnaligned(fromByteOffset: offset, as: DescriptorType.self)
+            }
+        }
+
+        public func makeIterator() -> Iterator {
+            Iterator(bytes: self.bytes, remainingCount: self.count)
+        }
+
+        /// The total size of the valid descriptors, in bytes.
+        fileprivate var totalSize: Int {
+            var iterator = self.makeIterator()
+            while iterator.nextType() != nil {}
+            return iterator.offset
+        }
+    }
+}
+
+// MARK: - Receiving
+extension Mach.Message {
+    /// Receives a message and calls a closure with a view of it in the receive buffer.
+    /// - Warning: This function will block until a message is received.
+    /// - Warning: The view is only valid for the duration of the closure and must not escape it.
+    public static func withReceivedMessage<ResultType>(
+        ofMaxSize maxSize: Int = Mach.Message.maxReceiveSize,
+        from localPort: Mach.Port,
+        options: consuming Mach.MessageOptions = [],
+        timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE,
+        using buffer: Mach.MessageBuffer? = nil,
+        _ body: (Mach.MessageView) throws -> ResultType
+    ) throws -> ResultType {
+        options.remove(.send)
+        options.insert(.receive)
+        if timeout != MACH_MSG_TIMEOUT_NONE { options.insert(.receiveTimeout) }
+        let receiveSize = max(maxSize, MemoryLayout<mach_msg_header_t>.size)
+        return try Mach.MessageBufferPool.withBuffer(buffer, minimumCapacity: receiveSize) {
+            try Self.message(
+                $0.headerPointer, options: options, sendSize: 0,
+                receiveSize: mach_msg_size_t(receiveSize), receivePort: localPort,
+                timeout: timeout,
+                notifyPort: Mach.Port.Nil
+            )
+            $0.clearUnusedTrailerBytes()
+            return try body(
+                Mach.MessageView(bytes: UnsafeRawBufferPointer(start: $0.baseAddress, count: receiveSize))
+            )
+        }
+    }
+}
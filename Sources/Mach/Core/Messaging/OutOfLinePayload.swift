@@ -0,0 +1,88 @@
+import Darwin.Mach
+import Foundation
+
+// MARK: - Out-Of-Line Payloads
+extension Mach.Message {
+    /// The payload size at or above which ``movePayloadOutOfLine(ifAtLeast:)`` moves a payload out of line by default.
+    /// - Note: Below a few pages, copying a payload inline is cheaper than remapping it.
+    public static var outOfLinePayloadThreshold: Int { 4 * Int(getpagesize()) }
+
+    /// Moves the payload into an out-of-line descriptor if it is at least a given size.
+    /// - Note: The kernel transfers the payload by remapping its pages copy-on-write, instead of copying it into and
+    ///   out of the kernel. A page-aligned payload is passed as it is; any other payload is first copied into pages of
+    ///   its own, as remapping its first page would expose the bytes before it to the receiver.
+    /// - Note: The descriptor refers to memory kept alive with the message, so the message can be sent any number of
+    ///   times. Setting ``automaticOutOfLineThreshold`` makes sending the message do this.
+    /// - Important: The out-of-line payload is appended as the last descriptor in the body, and the receiver must use
+    ///   ``takeOutOfLinePayload()`` to get it.
+    /// - Throws: An error if the payload is larger than a descriptor can describe.
+    /// - Returns: Whether the payload was moved.
+    @discardableResult
+    public func movePayloadOutOfLine(ifAtLeast threshold: Int = Mach.Message.outOfLinePayloadThreshold) throws -> Bool {
+        guard let payload = self.payload, !payload.isEmpty, payload.count >= threshold else { return false }
+        guard let descriptorSize = mach_msg_size_t(exactly: payload.count) else {
+            // We simulate a kernel error here, and "invalidArgument" makes the most sense.
+            throw MachError(.invalidArgument)
+        }
+        let pageSize = Int(getpagesize())
+        // Bridging keeps the payload's storage, so its bytes stay where they are for as long as we keep it.
+        let payloadStorage = payload as NSData
+        let storage: NSData
+        if payload.count >= pageSize, UInt(bitPattern: payloadStorage.bytes) % UInt(pageSize) == 0 {
+            storage = payloadStorage
+        } else {
+            var address: mach_vm_address_t = 0
+            try Mach.call(
+                mach_vm_allocate(mach_task_self_, &address, mach_vm_size_t(payload.count), VM_FLAGS_ANYWHERE)
+            )
+            let regionPointer = UnsafeMutableRawPointer(bitPattern: UInt(address))!
+            payload.copyBytes(to: UnsafeMutableRawBufferPointer(start: regionPointer, count: payload.count))
+            storage = NSData(bytesNoCopy: regionPointer, length: payload.count) { pointer, length in
+                mach_vm_deallocate(
+                    mach_task_self_, mach_vm_address_t(UInt(bitPattern: pointer)), mach_vm_size_t(length)
+                )
+            }
+        }
+        var body = self.body ?? Mach.MessageBody()
+        body.append(
+            mach_msg_ool_descriptor_t(
+                address: UnsafeMutableRawPointer(mutating: storage.bytes),
+                deallocate: 0,
+                copy: Mach.OOLDescriptorCopyOption.virtual.rawValue,
+                pad1: 0,
+                type: Mach.MessageDescriptorType.ool.rawValue,
+                size: descriptorSize
+            )
+        )
+        self.body = body
+        self.header.bits.isMessageComplex = true
+        self.outOfLinePayloadStorage = storage
+        self.payload = nil
+        return true
+    }
+
+    /// Removes the out-of-line payload from a received message and returns it.
+    /// - Note: The returned data refers to the region the kernel mapped into the task, without copying it, and
+    ///   deallocates the region with `mach_vm_deallocate` when it is released.
+    /// - Returns: The payload, or `nil` if the last descriptor in the body is not an out-of-line descriptor.
+    public func takeOutOfLinePayload() -> Data? {
+        guard var body = self.body,
+            let descriptor = body.removeLastDescriptor(ofType: .ool, as: mach_msg_ool_descriptor_t.self)
+        else { return nil }
+        if body.descriptorCount == 0 {
+            self.body = nil
+            self.header.bits.isMessageComplex = false
+        } else {
+            self.body = body
+        }
+        guard let address = descriptor.address else { return Data() }
+        return Data(
+            bytesNoCopy: address, count: Int(descriptor.size),
+            deallocator: .custom { pointer, count in
+                mach_vm_deallocate(
+                    mach_task_self_, mach_vm_address_t(UInt(bitPattern: pointer)), mach_vm_size_t(count)
+                )
+            }
+        )
+    }
+}
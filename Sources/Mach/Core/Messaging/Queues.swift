@@ -4,7 +4,7 @@ import Darwin.Mach
 extension Mach {
     /// A message queue.
     /// - Important: This does not support a combined send and receive operation. For such an operation, instead use the
-    /// ``Mach/Message/send(_:to:withDisposition:receiving:ofMaxSize:from:withDisposition:options:timeout:)`` function.
+    /// ``Mach/Message/send(_:to:withDisposition:receiving:ofMaxSize:from:withDisposition:options:timeout:using:)`` function.
     open class MessageQueue: Mach.Port {
         /// Sends a message to the queue.
         public func enqueue(
@@ -23,6 +23,65 @@ extension Mach {
         ) throws -> ReceiveMessage {
             try ReceiveMessage.receive(messageType, from: self, options: options, timeout: timeout)
         }
+
+        /// Sends messages to the queue, reusing one buffer for all of them.
+        /// - Note: If sending a message fails, the error is thrown and the remaining messages are not sent.
+        /// - Returns: The number of messages sent.
+        @discardableResult
+        public func enqueue<Messages: Sequence>(
+            contentsOf messages: Messages, options: Mach.MessageOptions = [],
+            timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
+        ) throws -> Int where Messages.Element: Mach.Message {
+            var sentCount = 0
+            try Mach.MessageBufferPool.withBuffer(minimumCapacity: Mach.Message.maxReceiveSize) { buffer in
+                for message in messages {
+                    try Mach.Message.send(message, to: self, options: options, timeout: timeout, using: buffer)
+                    sentCount += 1
+                }
+            }
+            return sentCount
+        }
+
+        /// Receives the messages available in the queue, up to a maximum count, reusing one buffer for all of them.
+        /// - Note: Only the first receive waits, for up to `timeout`. After that, the queue is drained without waiting.
+        /// - Warning: This function blocks until a message is received, unless a timeout is given.
+        /// - Returns: The number of messages received.
+        @discardableResult
+        public func dequeue<
+            ReceiveMessage: Mach.Message, Messages: RangeReplaceableCollection<ReceiveMessage>
+        >(
+            upTo maxCount: Int,
+            into messages: inout Messages,
+            ofMaxSize maxSize: Int = ReceiveMessage.maxReceiveSize,
+            options: Mach.MessageOptions = [],
+            timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
+        ) throws -> Int {
+            var receiveOptions = options
+            receiveOptions.remove(.send)
+            receiveOptions.insert(.receive)
+            let receiveSize = max(maxSize, MemoryLayout<mach_msg_header_t>.size)
+            var receivedCount = 0
+            try Mach.MessageBufferPool.withBuffer(minimumCapacity: receiveSize) { buffer in
+                while receivedCount < maxCount {
+                    let isDraining = receivedCount > 0
+                    // `MACH_MSG_TIMEOUT_NONE` is also zero, so draining needs the option to poll instead of block.
+                    let usesTimeout = isDraining || timeout != MACH_MSG_TIMEOUT_NONE
+                    let result = mach_msg(
+                        buffer.headerPointer,
+                        (usesTimeout ? receiveOptions.union(.receiveTimeout) : receiveOptions).rawValue,
+                        0, mach_msg_size_t(receiveSize), self.name, isDraining ? 0 : timeout,
+                        mach_port_name_t(MACH_PORT_NULL)
+                    )
+                    // Running out of messages while draining is not an error.
+                    if isDraining && result == MACH_RCV_TIMED_OUT { break }
+                    try Mach.call(result)
+                    buffer.clearUnusedTrailerBytes()
+                    messages.append(ReceiveMessage(headerPointer: buffer.headerPointer))
+                    receivedCount += 1
+                }
+            }
+            return receivedCount
+        }
     }
 }
 
@@ -39,6 +98,17 @@ extension Mach {
             // If the user somehow gets here, return an empty message.
             ReceiveMessage()
         }
+
+        @available(*, unavailable, message: "Clients can only enqueue messages.")
+        override public func dequeue<
+            ReceiveMessage: Mach.Message, Messages: RangeReplaceableCollection<ReceiveMessage>
+        >(
+            upTo maxCount: Int,
+            into messages: inout Messages,
+            ofMaxSize maxSize: Int = ReceiveMessage.maxReceiveSize,
+            options: Mach.MessageOptions = [],
+            timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
+        ) throws -> Int { 0 }
     }
 }
 
@@ -52,6 +122,12 @@ extension Mach {
             timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
         ) throws {}
 
+        @available(*, unavailable, message: "Servers can only dequeue messages.")
+        override public func enqueue<Messages: Sequence>(
+            contentsOf messages: Messages, options: Mach.MessageOptions = [],
+            timeout: mach_msg_timeout_t = MACH_MSG_TIMEOUT_NONE
+        ) throws -> Int where Messages.Element: Mach.Message { 0 }
+
         /// Sets the sequence number of the queue.
         public func setSequenceNumber(_ sequenceNumber: mach_port_seqno_t) throws {
             try Mach.call(
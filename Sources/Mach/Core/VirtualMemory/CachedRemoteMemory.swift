@@ -0,0 +1,31 @@
+import Darwin.Mach
+import Foundation
+import RemoteMemory
+
+// MARK: - Remote Memory Source
+
+extension Mach {
+    /// A source of memory from another address space.
+    /// - Note: This is defined in the platform-neutral `RemoteMemory` module, so that it can be tested anywhere.
+    public typealias RemoteMemorySource = RemoteMemory.RemoteMemorySource
+
+    /// A least-recently-used cache of page-sized chunks of memory from another address space.
+    /// - Note: This is defined in the platform-neutral `RemoteMemory` module, so that it can be tested anywhere.
+    public typealias CachedRemoteMemory<Source: RemoteMemorySource> = RemoteMemory.CachedRemoteMemory<Source>
+}
+
+#if os(macOS)
+    extension Mach.VirtualMemoryManager: Mach.RemoteMemorySource {
+        /// Reads exactly enough bytes to fill a buffer, starting at an address in the task's address space.
+        public func read(from address: mach_vm_address_t, into buffer: UnsafeMutableRawBufferPointer) throws {
+            guard !buffer.isEmpty else { return }
+            let readBytes = try self.read(
+                from: UnsafeRawPointer(bitPattern: UInt(address)), size: mach_vm_size_t(buffer.count),
+                into: buffer.baseAddress
+            )
+            guard readBytes.count == buffer.count else {
+                throw MachError(.failure)  // We simulate a kernel error here, and "failure" makes the most sense.
+            }
+        }
+    }
+#endif
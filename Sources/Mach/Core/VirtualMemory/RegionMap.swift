@@ -0,0 +1,160 @@
+#if os(macOS)
+    import Darwin.Mach
+    import Foundation
+
+    // MARK: - Region Map
+
+    extension Mach {
+        /// A snapshot of the regions in a task's address space, indexed by address.
+        /// - Note: The regions are stored as parallel arrays sorted by address, so that lookups only touch the
+        ///   addresses and take O(log n) time without calling the kernel.
+        public struct VMRegionMap: Sendable {
+            /// A region in a region map.
+            public struct Region: Sendable {
+                /// The address range of the region.
+                public let range: Range<mach_vm_address_t>
+
+                /// The current protection of the region.
+                public let protection: Mach.VMProtectionOptions
+
+                /// The maximum protection of the region.
+                public let maxProtection: Mach.VMProtectionOptions
+
+                /// The user tag of the region.
+                public let userTag: UInt32
+
+                /// The share mode of the region (such as `SM_COW` or `SM_PRIVATE`).
+                public let shareMode: UInt8
+
+                /// The submap depth of the region.
+                public let depth: UInt32
+            }
+
+            /// The start addresses of the regions.
+            private var starts: [mach_vm_address_t] = []
+
+            /// The end addresses of the regions.
+            private var ends: [mach_vm_address_t] = []
+
+            /// The current protections of the regions.
+            private var protections: [vm_prot_t] = []
+
+            /// The maximum protections of the regions.
+            private var maxProtections: [vm_prot_t] = []
+
+            /// The user tags of the regions.
+            private var userTags: [UInt32] = []
+
+            /// The share modes of the regions.
+            private var shareModes: [UInt8] = []
+
+            /// The submap depths of the regions.
+            private var depths: [UInt32] = []
+
+            /// The number of regions in the map.
+            public var count: Int { self.starts.count }
+
+            /// Appends a region to the map.
+            /// - Note: Regions must be appended in address order.
+            fileprivate mutating func append(_ region: Region) {
+                self.starts.append(region.range.lowerBound)
+                self.ends.append(region.range.upperBound)
+                self.protections.append(region.protection.rawValue)
+                self.maxProtections.append(region.maxProtection.rawValue)
+                self.userTags.append(region.userTag)
+                self.shareModes.append(region.shareMode)
+                self.depths.append(region.depth)
+            }
+
+            /// Gets the region at an index in the map.
+            public subscript(index: Int) -> Region {
+                Region(
+                    range: self.starts[index]..<self.ends[index],
+                    protection: Mach.VMProtectionOptions(rawValue: self.protections[index]),
+                    maxProtection: Mach.VMProtectionOptions(rawValue: self.maxProtections[index]),
+                    userTag: self.userTags[index],
+                    shareMode: self.shareModes[index],
+                    depth: self.depths[index]
+                )
+            }
+
+            /// The regions in the map, in address order.
+            public var regions: [Region] { (0..<self.count).map { self[$0] } }
+
+            /// Gets the index of the region containing an address.
+            public func index(containing address: mach_vm_address_t) -> Int? {
+                // Find the first region starting after the address.
+                var low = 0
+                var high = self.starts.count
+                while low < high {
+                    let middle = (low + high) / 2
+                    if self.starts[middle] <= address { low = middle + 1 } else { high = middle }
+                }
+                guard low > 0, address < self.ends[low - 1] else { return nil }
+                return low - 1
+            }
+
+            /// Gets the region containing an address.
+            public func region(containing address: mach_vm_address_t) -> Region? {
+                self.index(containing: address).map { self[$0] }
+            }
+
+            /// Gets a map of only the regions that match a set of criteria.
+            /// - Note: A region matches a protection if its current protection includes all of the given protection.
+            public func filtered(
+                protection: Mach.VMProtectionOptions? = nil, userTag: UInt32? = nil, shareMode: UInt8? = nil
+            ) -> Self {
+                var filteredMap = Self()
+                for index in 0..<self.count {
+                    if let protection, self.protections[index] & protection.rawValue != protection.rawValue {
+                        continue
+                    }
+                    if let userTag, self.userTags[index] != userTag { continue }
+                    if let shareMode, self.shareModes[index] != shareMode { continue }
+                    filteredMap.append(self[index])
+                }
+                return filteredMap
+            }
+        }
+    }
+
+    extension Mach.VirtualMemoryManager {
+        /// Walks every region in the task's address space, including the regions in submaps, into a region map.
+        /// - Note: Submaps themselves are not included, only the regions within them.
+        public func regionMap() throws -> Mach.VMRegionMap {
+            var regionMap = Mach.VMRegionMap()
+            var pointer: UnsafeRawPointer? = nil
+            var depth: natural_t = 0
+            while true {
+                let region: (data: vm_region_submap_info_64, size: mach_vm_size_t)
+                do {
+                    region = try self.regionRecurse(&pointer, depth: &depth)
+                } catch let error as MachError where error.code == .invalidAddress {
+                    // The kernel reports an invalid address once there are no more regions.
+                    break
+                }
+                let info = region.data
+                let address = try Self.unsafeRawPointerToMachVMAddress(pointer)
+                if info.is_submap != 0 {
+                    // Descend into the submap at the same address. The kernel reports the depth of each region it
+                    // returns, so we come back up once we walk past the end of the submap.
+                    depth += 1
+                    continue
+                }
+                // The kernel returns regions in address order, so the map stays sorted.
+                regionMap.append(
+                    Mach.VMRegionMap.Region(
+                        range: address..<address + region.size,
+                        protection: Mach.VMProtectionOptions(rawValue: info.protection),
+                        maxProtection: Mach.VMProtectionOptions(rawValue: info.max_protection),
+                        userTag: info.user_tag,
+                        shareMode: info.share_mode,
+                        depth: depth
+                    )
+                )
+                pointer = try Self.machVMAddressToUnsafeRawPointer(address + region.size)
+            }
+            return regionMap
+        }
+    }
+#endif
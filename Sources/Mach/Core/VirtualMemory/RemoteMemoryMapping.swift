@@ -0,0 +1,80 @@
+#if os(macOS)
+    import Darwin.Mach
+    import Foundation
+
+    // MARK: - Remote Memory Mapping
+
+    extension Mach.VirtualMemoryManager {
+        /// The size at or above which ``withUnsafeRemoteBytes(at:size:_:)`` maps a region instead of copying it.
+        /// - Note: Below a few pages, copying is cheaper than setting up and tearing down a mapping.
+        public static var remapThreshold: mach_vm_size_t { 16 * mach_vm_size_t(getpagesize()) }
+
+        /// Maps a region of the task's address space copy-on-write into the current task, and calls a closure with a
+        /// read-only view of it.
+        /// - Note: The region is unmapped when the closure returns, so no bytes are copied unless the task writes to
+        ///   them while they are mapped.
+        /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+        public func withMappedRemoteRegion<ResultType>(
+            address: mach_vm_address_t, size: mach_vm_size_t,
+            _ body: (UnsafeRawBufferPointer) throws -> ResultType
+        ) throws -> ResultType {
+            // Mappings must be page-aligned, so we map the surrounding pages and offset into them.
+            let pageMask = mach_vm_address_t(getpagesize()) - 1
+            let alignedAddress = address & ~pageMask
+            let offsetInMapping = Int(address - alignedAddress)
+            // A size this large could never be mapped, so we reject it rather than let the rounding overflow.
+            guard let byteCount = Int(exactly: size),
+                size <= mach_vm_size_t.max - mach_vm_size_t(offsetInMapping) - pageMask
+            else {
+                throw MachError(.invalidArgument)  // We simulate a kernel error here, and "invalidArgument" makes the most sense.
+            }
+            let alignedSize = (mach_vm_size_t(offsetInMapping) + size + pageMask) & ~pageMask
+            let sourcePointer = try Self.machVMAddressToUnsafeRawPointer(alignedAddress)
+            let currentVM = Mach.Task.current.vm
+            var mappedPointer: UnsafeRawPointer? = nil
+            if #available(macOS 12.0.1, *) {
+                // Only a read right to the task is needed when requesting a read-only mapping.
+                var currentProtection = Mach.VMProtectionOptions.read
+                var maxProtection = Mach.VMProtectionOptions.read
+                try currentVM.remapNew(
+                    into: &mappedPointer, size: alignedSize, flags: [.anywhere], fromTask: self.task,
+                    fromPointer: sourcePointer, copy: true, currentProtection: &currentProtection,
+                    maxProtection: &maxProtection, inheritance: .none
+                )
+            } else {
+                _ = try currentVM.remap(
+                    into: &mappedPointer, size: alignedSize, flags: [.anywhere], fromTask: self.task,
+                    fromPointer: sourcePointer, copy: true, inheritance: .none
+                )
+            }
+            defer { try? currentVM.deallocate(mappedPointer, size: alignedSize) }
+            return try body(UnsafeRawBufferPointer(start: mappedPointer.map { $0 + offsetInMapping }, count: byteCount))
+        }
+
+        /// Calls a closure with the bytes of a region of the task's address space, copying small regions and mapping
+        /// large ones.
+        /// - Note: Regions of at least ``remapThreshold`` bytes are mapped with
+        ///   ``withMappedRemoteRegion(address:size:_:)``, and smaller regions are copied into temporary storage.
+        /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+        public func withUnsafeRemoteBytes<ResultType>(
+            at address: mach_vm_address_t, size: mach_vm_size_t,
+            _ body: (UnsafeRawBufferPointer) throws -> ResultType
+        ) throws -> ResultType {
+            if size >= Self.remapThreshold {
+                return try self.withMappedRemoteRegion(address: address, size: size, body)
+            }
+            return try withUnsafeTemporaryAllocation(
+                byteCount: Int(size), alignment: MemoryLayout<UInt64>.alignment
+            ) { buffer in
+                let readBytes = try self.read(
+                    from: try Self.machVMAddressToUnsafeRawPointer(address), size: size, into: buffer.baseAddress
+                )
+                // The closure is promised the whole region, as it would get from a mapping.
+                guard readBytes.count == buffer.count else {
+                    throw MachError(.failure)  // We simulate a kernel error here, and "failure" makes the most sense.
+                }
+                return try body(readBytes)
+            }
+        }
+    }
+#endif
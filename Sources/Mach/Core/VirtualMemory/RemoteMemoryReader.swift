@@ -0,0 +1,141 @@
+#if os(macOS)
+    import Darwin.Mach
+    import Foundation
+
+    // MARK: - Remote Memory Reader
+
+    extension Mach {
+        /// A reader that gathers many small reads from a task's address space into as few kernel calls as possible.
+        /// - Note: Requested ranges that share or border pages are coalesced into a single page-aligned range, which is
+        ///   read with one `mach_vm_read_overwrite` call into a buffer that is reused across reads.
+        public final class RemoteMemoryReader {
+            /// The virtual memory manager of the task to read from.
+            public let vm: Mach.VirtualMemoryManager
+
+            /// The maximum size of a coalesced range.
+            /// - Note: Requested ranges larger than this are still read, but are never coalesced with other ranges.
+            public let maximumCoalescedSize: Int
+
+            /// The number of kernel calls the reader has made.
+            public private(set) var kernelCallCount = 0
+
+            /// The buffer that ranges are read into.
+            private var buffer: UnsafeMutableRawPointer
+
+            /// The capacity of the buffer.
+            private var bufferCapacity: Int
+
+            /// The page size used to align coalesced ranges.
+            private static var pageSize: mach_vm_size_t { mach_vm_size_t(getpagesize()) }
+
+            /// Creates a reader for a task's address space.
+            public init(vm: Mach.VirtualMemoryManager, maximumCoalescedSize: Int = 1 << 20) {
+                self.vm = vm
+                self.maximumCoalescedSize = maximumCoalescedSize
+                self.bufferCapacity = Int(Self.pageSize)
+                self.buffer = UnsafeMutableRawPointer.allocate(
+                    byteCount: self.bufferCapacity, alignment: Int(Self.pageSize)
+                )
+            }
+
+            deinit { self.buffer.deallocate() }
+
+            /// Reads a range into the start of the buffer.
+            /// - Returns: Whether the whole range was read.
+            private func readIntoBuffer(_ range: Range<mach_vm_address_t>) -> Bool {
+                let size = Int(range.upperBound - range.lowerBound)
+                if size > self.bufferCapacity {
+                    self.buffer.deallocate()
+                    self.bufferCapacity = max(size, self.bufferCapacity * 2)
+                    self.buffer = UnsafeMutableRawPointer.allocate(
+                        byteCount: self.bufferCapacity, alignment: Int(Self.pageSize)
+                    )
+                }
+                var outSize: mach_vm_size_t = 0
+                self.kernelCallCount += 1
+                let result = mach_vm_read_overwrite(
+                    self.vm.task.name, range.lowerBound, mach_vm_size_t(size),
+                    mach_vm_address_t(UInt(bitPattern: self.buffer)), &outSize
+                )
+                return result == KERN_SUCCESS && outSize == mach_vm_size_t(size)
+            }
+
+            /// Reads a set of ranges from the task's address space and passes each one to a closure.
+            /// - Note: The closure is called once for each range, in address order, with the index of the range and its
+            ///   bytes, or `nil` if the range could not be read.
+            /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+            public func read(
+                _ ranges: [Range<mach_vm_address_t>],
+                _ body: (_ index: Int, _ bytes: UnsafeRawBufferPointer?) throws -> Void
+            ) rethrows {
+                let pageMask = Self.pageSize - 1
+                let alignedRanges = ranges.map { range in
+                    // If the end would overflow when rounded up, the range is left unaligned at its end.
+                    let (alignedEnd, overflow) = range.upperBound.addingReportingOverflow(pageMask)
+                    return (range.lowerBound & ~pageMask)..<(overflow ? range.upperBound : alignedEnd & ~pageMask)
+                }
+                let order = ranges.indices.sorted { ranges[$0].lowerBound < ranges[$1].lowerBound }
+
+                var groupStart = 0
+                while groupStart < order.count {
+                    // Extend the group while the next range shares or borders its pages.
+                    var span = alignedRanges[order[groupStart]]
+                    var groupEnd = groupStart + 1
+                    while groupEnd < order.count {
+                        let alignedRange = alignedRanges[order[groupEnd]]
+                        let spanEnd = max(span.upperBound, alignedRange.upperBound)
+                        guard alignedRange.lowerBound <= span.upperBound,
+                            spanEnd - span.lowerBound <= mach_vm_size_t(self.maximumCoalescedSize)
+                        else { break }
+                        span = span.lowerBound..<spanEnd
+                        groupEnd += 1
+                    }
+                    let group = order[groupStart..<groupEnd]
+                    groupStart = groupEnd
+
+                    if span.isEmpty || self.readIntoBuffer(span) {
+                        for index in group {
+                            let offset = Int(ranges[index].lowerBound - span.lowerBound)
+                            try body(
+                                index, UnsafeRawBufferPointer(start: self.buffer + offset, count: ranges[index].count)
+                            )
+                        }
+                        continue
+                    }
+
+                    // Part of the span is unreadable, so fall back to reading each range on its own.
+                    for index in group {
+                        let range = ranges[index]
+                        let isReadable = self.readIntoBuffer(range)
+                        try body(index, isReadable ? UnsafeRawBufferPointer(start: self.buffer, count: range.count) : nil)
+                    }
+                }
+            }
+
+            /// Reads a value at each of a set of addresses in the task's address space.
+            /// - Returns: The values, in the same order as the addresses, or `nil` for each value that could not be read.
+            public func read<T: BitwiseCopyable>(
+                _ type: T.Type = T.self, at addresses: [mach_vm_address_t]
+            ) -> [T?] {
+                var values = [T?](repeating: nil, count: addresses.count)
+                let size = mach_vm_size_t(MemoryLayout<T>.size)
+                // A value whose end would overflow the address space cannot be read, so it is left as `nil` like any
+                // other value that could not be read.
+                var readIndices: [Int] = []
+                var ranges: [Range<mach_vm_address_t>] = []
+                readIndices.reserveCapacity(addresses.count)
+                ranges.reserveCapacity(addresses.count)
+                for (index, address) in addresses.enumerated() {
+                    let (end, overflow) = address.addingReportingOverflow(size)
+                    guard !overflow else { continue }
+                    readIndices.append(index)
+                    ranges.append(address..<end)
+                }
+                self.read(ranges) { index, bytes in
+                    values[readIndices[index]] = bytes?.loadUnaligned(as: T.self)
+                }
+                return values
+            }
+        }
+    }
+#endif
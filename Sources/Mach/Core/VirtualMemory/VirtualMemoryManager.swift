@@ -287,9 +287,19 @@
 
     extension Mach.VirtualMemoryManager {
         /// Reads a value from a virtual memory region in the task's address space.
+        /// - Note: The value is read directly into local storage, so no kernel-allocated buffer is left behind.
         public func read<T: BitwiseCopyable>(from inPointer: UnsafePointer<T>?) throws -> T {
-            return try self.read(from: inPointer, size: mach_vm_size_t(MemoryLayout<T>.size))
-                .load(as: T.self)
+            try withUnsafeTemporaryAllocation(
+                byteCount: MemoryLayout<T>.size, alignment: MemoryLayout<T>.alignment
+            ) { valueBytes in
+                let readBytes = try self.read(
+                    from: inPointer, size: mach_vm_size_t(valueBytes.count), into: valueBytes.baseAddress
+                )
+                guard readBytes.count == valueBytes.count else {
+                    throw MachError(.failure)  // We simulate a kernel error here, and "failure" makes the most sense.
+                }
+                return readBytes.loadUnaligned(as: T.self)
+            }
         }
 
         /// Writes a value into a virtual memory region in the task's address space.
@@ -304,18 +314,70 @@
 
     extension Mach.VirtualMemoryManager {
         /// Reads a null-terminated string from a virtual memory region in the task's address space.
+        /// - Note: The string is read in chunks that end at page boundaries, so that no chunk can span into an unmapped
+        ///   page, and a short string takes only one or two kernel calls.
         public func readNullTerminatedString(
             from pointer: UnsafePointer<Int8>, encoding: String.Encoding
         ) throws -> String? {
-            var walkingPointer = pointer
+            let address = try Self.unsafeRawPointerToMachVMAddress(pointer)
+            return String(data: try self.readNullTerminatedBytes(from: address), encoding: encoding)
+        }
+
+        /// Reads a null-terminated string from each of a set of virtual memory regions in the task's address space.
+        /// - Note: The start of each string is read with a ``Mach/RemoteMemoryReader``, so strings that are close
+        ///   together (such as image paths) are read in the same kernel calls. Any string that is longer than the
+        ///   initial read is then finished on its own.
+        /// - Returns: The strings, in the same order as the pointers, or `nil` for each string that could not be read
+        ///   or decoded.
+        public func readNullTerminatedStrings(
+            from pointers: [UnsafePointer<Int8>], encoding: String.Encoding, initialReadSize: Int = 256
+        ) -> [String?] {
+            let pageSize = mach_vm_size_t(getpagesize())
+            let addresses = pointers.map { mach_vm_address_t(UInt(bitPattern: $0)) }
+            // Don't let the initial reads cross a page boundary, as the next page may be unmapped.
+            let ranges = addresses.map { address in
+                let pageEnd = (address | (pageSize - 1)) &+ 1
+                return address..<(pageEnd == 0 ? address : min(address + mach_vm_size_t(initialReadSize), pageEnd))
+            }
+            var strings = [String?](repeating: nil, count: pointers.count)
+            Mach.RemoteMemoryReader(vm: self).read(ranges) { index, bytes in
+                guard let bytes else { return }
+                if let terminatorIndex = bytes.firstIndex(of: 0) {
+                    strings[index] = String(data: Data(bytes[..<terminatorIndex]), encoding: encoding)
+                } else if let rest = try? self.readNullTerminatedBytes(from: ranges[index].upperBound) {
+                    strings[index] = String(data: Data(bytes) + rest, encoding: encoding)
+                }
+            }
+            return strings
+        }
+
+        /// Reads bytes starting at an address up to, but not including, the first null byte.
+        private func readNullTerminatedBytes(from address: mach_vm_address_t) throws -> Data {
+            let pageSize = Int(getpagesize())
             var resultData = Data()
-            while true {
-                let byte = try self.read(from: walkingPointer)
-                if byte == Int8(0) { break }
-                resultData.append(UInt8(byte))
-                walkingPointer = walkingPointer.advanced(by: 1)
+            try withUnsafeTemporaryAllocation(byteCount: pageSize, alignment: pageSize) { chunkBuffer in
+                var chunkAddress = address
+                while true {
+                    let chunkSize = pageSize - Int(chunkAddress & mach_vm_address_t(pageSize - 1))
+                    let chunk = try self.read(
+                        from: try Self.machVMAddressToUnsafeRawPointer(chunkAddress),
+                        size: mach_vm_size_t(chunkSize), into: chunkBuffer.baseAddress
+                    )
+                    guard !chunk.isEmpty else {
+                        throw MachError(.failure)  // We simulate a kernel error here, and "failure" makes the most sense.
+                    }
+                    if let terminator = memchr(chunk.baseAddress!, 0, chunk.count) {
+                        resultData.append(
+                            chunk.baseAddress!.assumingMemoryBound(to: UInt8.self),
+                            count: chunk.baseAddress!.distance(to: UnsafeRawPointer(terminator))
+                        )
+                        return
+                    }
+                    resultData.append(chunk.baseAddress!.assumingMemoryBound(to: UInt8.self), count: chunk.count)
+                    chunkAddress += mach_vm_address_t(chunk.count)
+                }
             }
-            return String(data: resultData, encoding: encoding)
+            return resultData
         }
     }
 
@@ -693,10 +755,10 @@
         /// Gets recursive information about a virtual memory region in the task's address space.
         public func regionRecurse(
             _ pointer: inout UnsafeRawPointer?, depth: inout UInt32
-        ) throws -> (data: vm_region_submap_info_64_t, size: mach_vm_size_t) {
+        ) throws -> (data: vm_region_submap_info_64, size: mach_vm_size_t) {
             var address = try Mach.VirtualMemoryManager.unsafeRawPointerToMachVMAddress(pointer)
             var size: mach_vm_size_t = 0
-            let data = try Mach.callWithCountInOut(type: vm_region_submap_info_64_t.self) {
+            let data = try Mach.callWithCountInOut(type: vm_region_submap_info_64.self) {
                 array, count in
                 return mach_vm_region_recurse(
                     self.task.name, &address, &size, &depth, array, &count
@@ -0,0 +1,361 @@
+import Foundation
+import MachCore
+import MachO
+
+extension Mach {
+    /// A C structure whose integer fields can be byte-swapped.
+    public protocol ByteSwappable: BitwiseCopyable {
+        /// The structure with its integer fields byte-swapped.
+        /// - Note: Byte arrays (such as names) are not swapped.
+        var byteSwapped: Self { get }
+    }
+}
+
+/// Byte-swaps a structure stored at the start of a buffer in place.
+/// - Note: If the buffer is shorter than the structure, only the bytes in the buffer are written back.
+internal func byteSwapStructure<StructureType: Mach.ByteSwappable>(
+    _ type: StructureType.Type, in bytes: UnsafeMutableRawBufferPointer
+) {
+    let count = min(bytes.count, MemoryLayout<StructureType>.size)
+    guard count == MemoryLayout<StructureType>.size else {
+        // Pad a truncated structure with zeroes so that it can be loaded.
+        var paddedBytes = [UInt8](repeating: 0, count: MemoryLayout<StructureType>.size)
+        paddedBytes.withUnsafeMutableBytes {
+            $0.copyMemory(from: UnsafeRawBufferPointer(rebasing: bytes[..<count]))
+            byteSwapStructure(type, in: $0)
+            bytes.copyMemory(from: UnsafeRawBufferPointer(rebasing: $0[..<count]))
+        }
+        return
+    }
+    let value = bytes.loadUnaligned(as: StructureType.self)
+    withUnsafeBytes(of: value.byteSwapped) { bytes.copyMemory(from: $0) }
+}
+
+extension Mach {
+    /// A byte order of a Mach object, relative to the host.
+    /// - Note: This is used as a generic parameter so that readers are specialized at compile time, and readers of
+    ///   native objects do not pay for swapping.
+    public protocol ByteOrder {
+        /// Converts a structure from this byte order to the host byte order.
+        static func toHost<StructureType: Mach.ByteSwappable>(_ value: StructureType) -> StructureType
+
+        /// Converts an integer from this byte order to the host byte order.
+        static func toHost<IntegerType: FixedWidthInteger>(_ value: IntegerType) -> IntegerType
+    }
+
+    /// The host byte order.
+    public enum HostByteOrder: Mach.ByteOrder {
+        @inlinable @inline(__always)
+        public static func toHost<StructureType: Mach.ByteSwappable>(_ value: StructureType) -> StructureType {
+            value
+        }
+
+        @inlinable @inline(__always)
+        public static func toHost<IntegerType: FixedWidthInteger>(_ value: IntegerType) -> IntegerType {
+            value
+        }
+    }
+
+    /// The opposite of the host byte order.
+    public enum SwappedByteOrder: Mach.ByteOrder {
+        @inlinable @inline(__always)
+        public static func toHost<StructureType: Mach.ByteSwappable>(_ value: StructureType) -> StructureType {
+            value.byteSwapped
+        }
+
+        @inlinable @inline(__always)
+        public static func toHost<IntegerType: FixedWidthInteger>(_ value: IntegerType) -> IntegerType {
+            value.byteSwapped
+        }
+    }
+}
+
+// MARK: - Swapped Fields
+
+extension mach_header: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.magic = self.magic.byteSwapped
+        swapped.cputype = self.cputype.byteSwapped
+        swapped.cpusubtype = self.cpusubtype.byteSwapped
+        swapped.filetype = self.filetype.byteSwapped
+        swapped.ncmds = self.ncmds.byteSwapped
+        swapped.sizeofcmds = self.sizeofcmds.byteSwapped
+        swapped.flags = self.flags.byteSwapped
+        return swapped
+    }
+}
+
+extension mach_header_64: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.magic = self.magic.byteSwapped
+        swapped.cputype = self.cputype.byteSwapped
+        swapped.cpusubtype = self.cpusubtype.byteSwapped
+        swapped.filetype = self.filetype.byteSwapped
+        swapped.ncmds = self.ncmds.byteSwapped
+        swapped.sizeofcmds = self.sizeofcmds.byteSwapped
+        swapped.flags = self.flags.byteSwapped
+        swapped.reserved = self.reserved.byteSwapped
+        return swapped
+    }
+}
+
+extension load_command: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        return swapped
+    }
+}
+
+extension segment_command: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        swapped.vmaddr = self.vmaddr.byteSwapped
+        swapped.vmsize = self.vmsize.byteSwapped
+        swapped.fileoff = self.fileoff.byteSwapped
+        swapped.filesize = self.filesize.byteSwapped
+        swapped.maxprot = self.maxprot.byteSwapped
+        swapped.initprot = self.initprot.byteSwapped
+        swapped.nsects = self.nsects.byteSwapped
+        swapped.flags = self.flags.byteSwapped
+        return swapped
+    }
+}
+
+extension segment_command_64: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        swapped.vmaddr = self.vmaddr.byteSwapped
+        swapped.vmsize = self.vmsize.byteSwapped
+        swapped.fileoff = self.fileoff.byteSwapped
+        swapped.filesize = self.filesize.byteSwapped
+        swapped.maxprot = self.maxprot.byteSwapped
+        swapped.initprot = self.initprot.byteSwapped
+        swapped.nsects = self.nsects.byteSwapped
+        swapped.flags = self.flags.byteSwapped
+        return swapped
+    }
+}
+
+extension section: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.addr = self.addr.byteSwapped
+        swapped.size = self.size.byteSwapped
+        swapped.offset = self.offset.byteSwapped
+        swapped.align = self.align.byteSwapped
+        swapped.reloff = self.reloff.byteSwapped
+        swapped.nreloc = self.nreloc.byteSwapped
+        swapped.flags = self.flags.byteSwapped
+        swapped.reserved1 = self.reserved1.byteSwapped
+        swapped.reserved2 = self.reserved2.byteSwapped
+        return swapped
+    }
+}
+
+extension section_64: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.addr = self.addr.byteSwapped
+        swapped.size = self.size.byteSwapped
+        swapped.offset = self.offset.byteSwapped
+        swapped.align = self.align.byteSwapped
+        swapped.reloff = self.reloff.byteSwapped
+        swapped.nreloc = self.nreloc.byteSwapped
+        swapped.flags = self.flags.byteSwapped
+        swapped.reserved1 = self.reserved1.byteSwapped
+        swapped.reserved2 = self.reserved2.byteSwapped
+        swapped.reserved3 = self.reserved3.byteSwapped
+        return swapped
+    }
+}
+
+extension symtab_command: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        swapped.symoff = self.symoff.byteSwapped
+        swapped.nsyms = self.nsyms.byteSwapped
+        swapped.stroff = self.stroff.byteSwapped
+        swapped.strsize = self.strsize.byteSwapped
+        return swapped
+    }
+}
+
+extension dysymtab_command: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        swapped.ilocalsym = self.ilocalsym.byteSwapped
+        swapped.nlocalsym = self.nlocalsym.byteSwapped
+        swapped.iextdefsym = self.iextdefsym.byteSwapped
+        swapped.nextdefsym = self.nextdefsym.byteSwapped
+        swapped.iundefsym = self.iundefsym.byteSwapped
+        swapped.nundefsym = self.nundefsym.byteSwapped
+        swapped.tocoff = self.tocoff.byteSwapped
+        swapped.ntoc = self.ntoc.byteSwapped
+        swapped.modtaboff = self.modtaboff.byteSwapped
+        swapped.nmodtab = self.nmodtab.byteSwapped
+        swapped.extrefsymoff = self.extrefsymoff.byteSwapped
+        swapped.nextrefsyms = self.nextrefsyms.byteSwapped
+        swapped.indirectsymoff = self.indirectsymoff.byteSwapped
+        swapped.nindirectsyms = self.nindirectsyms.byteSwapped
+        swapped.extreloff = self.extreloff.byteSwapped
+        swapped.nextrel = self.nextrel.byteSwapped
+        swapped.locreloff = self.locreloff.byteSwapped
+        swapped.nlocrel = self.nlocrel.byteSwapped
+        return swapped
+    }
+}
+
+extension dyld_info_command: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        swapped.rebase_off = self.rebase_off.byteSwapped
+        swapped.rebase_size = self.rebase_size.byteSwapped
+        swapped.bind_off = self.bind_off.byteSwapped
+        swapped.bind_size = self.bind_size.byteSwapped
+        swapped.weak_bind_off = self.weak_bind_off.byteSwapped
+        swapped.weak_bind_size = self.weak_bind_size.byteSwapped
+        swapped.lazy_bind_off = self.lazy_bind_off.byteSwapped
+        swapped.lazy_bind_size = self.lazy_bind_size.byteSwapped
+        swapped.export_off = self.export_off.byteSwapped
+        swapped.export_size = self.export_size.byteSwapped
+        return swapped
+    }
+}
+
+extension linkedit_data_command: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        swapped.dataoff = self.dataoff.byteSwapped
+        swapped.datasize = self.datasize.byteSwapped
+        return swapped
+    }
+}
+
+extension dylib_command: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        swapped.dylib.name.offset = self.dylib.name.offset.byteSwapped
+        swapped.dylib.timestamp = self.dylib.timestamp.byteSwapped
+        swapped.dylib.current_version = self.dylib.current_version.byteSwapped
+        swapped.dylib.compatibility_version = self.dylib.compatibility_version.byteSwapped
+        return swapped
+    }
+}
+
+extension uuid_command: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        return swapped
+    }
+}
+
+extension build_version_command: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        swapped.platform = self.platform.byteSwapped
+        swapped.minos = self.minos.byteSwapped
+        swapped.sdk = self.sdk.byteSwapped
+        swapped.ntools = self.ntools.byteSwapped
+        return swapped
+    }
+}
+
+extension build_tool_version: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.tool = self.tool.byteSwapped
+        swapped.version = self.version.byteSwapped
+        return swapped
+    }
+}
+
+extension entry_point_command: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        swapped.entryoff = self.entryoff.byteSwapped
+        swapped.stacksize = self.stacksize.byteSwapped
+        return swapped
+    }
+}
+
+extension encryption_info_command_64: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cmd = self.cmd.byteSwapped
+        swapped.cmdsize = self.cmdsize.byteSwapped
+        swapped.cryptoff = self.cryptoff.byteSwapped
+        swapped.cryptsize = self.cryptsize.byteSwapped
+        swapped.cryptid = self.cryptid.byteSwapped
+        swapped.pad = self.pad.byteSwapped
+        return swapped
+    }
+}
+
+extension nlist: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.n_un.n_strx = self.n_un.n_strx.byteSwapped
+        swapped.n_desc = self.n_desc.byteSwapped
+        swapped.n_value = self.n_value.byteSwapped
+        return swapped
+    }
+}
+
+extension nlist_64: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.n_un.n_strx = self.n_un.n_strx.byteSwapped
+        swapped.n_desc = self.n_desc.byteSwapped
+        swapped.n_value = self.n_value.byteSwapped
+        return swapped
+    }
+}
+
+extension fat_arch: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cputype = self.cputype.byteSwapped
+        swapped.cpusubtype = self.cpusubtype.byteSwapped
+        swapped.offset = self.offset.byteSwapped
+        swapped.size = self.size.byteSwapped
+        swapped.align = self.align.byteSwapped
+        return swapped
+    }
+}
+
+extension fat_arch_64: Mach.ByteSwappable {
+    public var byteSwapped: Self {
+        var swapped = self
+        swapped.cputype = self.cputype.byteSwapped
+        swapped.cpusubtype = self.cpusubtype.byteSwapped
+        swapped.offset = self.offset.byteSwapped
+        swapped.size = self.size.byteSwapped
+        swapped.align = self.align.byteSwapped
+        swapped.reserved = self.reserved.byteSwapped
+        return swapped
+    }
+}
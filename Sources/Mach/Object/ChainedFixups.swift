@@ -0,0 +1,430 @@
+import Foundation
+import MachCore
+import MachO
+
+extension Mach {
+    /// The chained fixups of a Mach object, as referenced by `LC_DYLD_CHAINED_FIXUPS`.
+    /// - Note: Fixups are decoded as they are walked, and the full list is never materialized.
+    public struct ChainedFixups: Sendable {
+        /// A fixup in a chain.
+        public struct Fixup: Sendable {
+            /// The target of a fixup.
+            public enum Target: Sendable {
+                /// The fixup is a rebase to an offset from the start of the image, with an optional high byte.
+                case rebase(targetOffset: UInt64, high8: UInt8)
+
+                /// The fixup is a bind to an import, with an addend.
+                case bind(importIndex: UInt32, addend: Int64)
+            }
+
+            /// The pointer authentication information of a fixup.
+            public struct Authentication: Sendable {
+                /// The key used to sign the pointer.
+                public let key: UInt8
+
+                /// The diversity value used to sign the pointer.
+                public let diversity: UInt16
+
+                /// Whether the address of the pointer is blended into the diversity.
+                public let hasAddressDiversity: Bool
+            }
+
+            /// The index of the segment containing the fixup.
+            public let segmentIndex: Int
+
+            /// The offset of the fixup in its segment.
+            public let segmentOffset: UInt64
+
+            /// The file offset of the fixup.
+            public let fileOffset: Int
+
+            /// The target of the fixup.
+            public let target: Target
+
+            /// The pointer authentication information of the fixup, if the pointer is signed.
+            public let authentication: Authentication?
+        }
+
+        /// An imported symbol referenced by bind fixups.
+        public struct Import: Sendable {
+            /// The ordinal of the library the symbol is imported from.
+            /// - Note: Special ordinals (such as for flat lookups) are negative.
+            public let libraryOrdinal: Int
+
+            /// Whether the import is weak.
+            public let isWeak: Bool
+
+            /// The offset of the name of the symbol in the symbol string pool.
+            internal let nameOffset: UInt32
+
+            /// The addend of the import.
+            public let addend: Int64
+        }
+
+        /// The raw data of the object containing the fixups.
+        private let data: Data
+
+        /// The range of the fixups in the object's data.
+        private let range: Range<Int>
+
+        /// The layouts of the segments in the object.
+        private let segmentLayouts: [Mach.SegmentLayout]
+
+        /// The preferred load address of the object.
+        private let preferredLoadAddress: UInt64
+
+        /// Represents the chained fixups at a file range in a Mach object.
+        public init(object: some Mach.Object, fileRange: Range<Int>) {
+            self.data = object.data
+            self.range = fileRange.clamped(to: 0..<object.data.count)
+            self.segmentLayouts = object.segmentLayouts
+            self.preferredLoadAddress = object.preferredLoadAddress
+        }
+
+        /// Calls a closure with a borrowed view of the fixups data.
+        private func withUnsafeFixupsBytes<ResultType>(
+            _ body: (UnsafeRawBufferPointer) throws -> ResultType
+        ) rethrows -> ResultType {
+            try self.data.withUnsafeBytes {
+                try body(UnsafeRawBufferPointer(rebasing: $0[self.range]))
+            }
+        }
+
+        /// Reads an integer at an offset in a buffer, or zero if the buffer is too small.
+        private static func read<IntegerType: FixedWidthInteger>(
+            _ type: IntegerType.Type, at offset: Int, in bytes: UnsafeRawBufferPointer
+        ) -> IntegerType {
+            guard offset >= 0, offset + MemoryLayout<IntegerType>.size <= bytes.count else { return 0 }
+            return bytes.loadUnaligned(fromByteOffset: offset, as: IntegerType.self)
+        }
+    }
+}
+
+// MARK: - Header
+
+extension Mach.ChainedFixups {
+    /// The layout of `dyld_chained_fixups_header`.
+    private enum HeaderOffset {
+        static let startsOffset = 4
+        static let importsOffset = 8
+        static let symbolsOffset = 12
+        static let importsCount = 16
+        static let importsFormat = 20
+    }
+
+    /// The import formats.
+    private enum ImportFormat {
+        /// `DYLD_CHAINED_IMPORT`
+        static let standard: UInt32 = 1
+
+        /// `DYLD_CHAINED_IMPORT_ADDEND`
+        static let addend: UInt32 = 2
+
+        /// `DYLD_CHAINED_IMPORT_ADDEND64`
+        static let addend64: UInt32 = 3
+    }
+
+    /// The number of imports.
+    public var numberOfImports: UInt32 {
+        self.withUnsafeFixupsBytes { Self.read(UInt32.self, at: HeaderOffset.importsCount, in: $0) }
+    }
+
+    /// The number of imports that fit in the fixups data.
+    /// - Note: This is at most ``numberOfImports``, which is read from the header and may be too large in a
+    ///   malformed object.
+    internal var numberOfReadableImports: Int {
+        self.withUnsafeFixupsBytes { fixupsBytes in
+            let importsOffset = Int(Self.read(UInt32.self, at: HeaderOffset.importsOffset, in: fixupsBytes))
+            let entrySize: Int
+            switch Self.read(UInt32.self, at: HeaderOffset.importsFormat, in: fixupsBytes) {
+            case ImportFormat.standard: entrySize = 4
+            case ImportFormat.addend: entrySize = 8
+            case ImportFormat.addend64: entrySize = 16
+            default: return 0
+            }
+            let importsCount = Int(Self.read(UInt32.self, at: HeaderOffset.importsCount, in: fixupsBytes))
+            return min(importsCount, max(fixupsBytes.count - importsOffset, 0) / entrySize)
+        }
+    }
+
+    /// Gets an import by index.
+    public func `import`(at index: UInt32) -> Import? {
+        self.withUnsafeFixupsBytes { Self.readImport(at: index, in: $0) }
+    }
+
+    /// Gets the name of an import.
+    public func name(of import: Import) -> String {
+        self.withUnsafeFixupsBytes { fixupsBytes in
+            let symbolsOffset = Int(Self.read(UInt32.self, at: HeaderOffset.symbolsOffset, in: fixupsBytes))
+            let nameStart = symbolsOffset + Int(`import`.nameOffset)
+            guard nameStart < fixupsBytes.count else { return "" }
+            return String(decoding: fixupsBytes[nameStart...].prefix { $0 != 0 }, as: UTF8.self)
+        }
+    }
+
+    /// Reads an import from the fixups data.
+    private static func readImport(at index: UInt32, in fixupsBytes: UnsafeRawBufferPointer) -> Import? {
+        guard index < Self.read(UInt32.self, at: HeaderOffset.importsCount, in: fixupsBytes) else { return nil }
+        let importsOffset = Int(Self.read(UInt32.self, at: HeaderOffset.importsOffset, in: fixupsBytes))
+        let importsFormat = Self.read(UInt32.self, at: HeaderOffset.importsFormat, in: fixupsBytes)
+        switch importsFormat {
+        case ImportFormat.standard, ImportFormat.addend:
+            let isAddendFormat = importsFormat == ImportFormat.addend
+            let stride = isAddendFormat ? 8 : 4
+            let rawImport = Self.read(UInt32.self, at: importsOffset + Int(index) * stride, in: fixupsBytes)
+            let addend =
+                isAddendFormat
+                ? Int64(Self.read(Int32.self, at: importsOffset + Int(index) * stride + 4, in: fixupsBytes))
+                : 0
+            let rawOrdinal = UInt8(truncatingIfNeeded: rawImport)
+            return Import(
+                // Only the top few values of the ordinal are special, so only sign-extend those.
+                libraryOrdinal: rawOrdinal >= 0xF0 ? Int(Int8(bitPattern: rawOrdinal)) : Int(rawOrdinal),
+                isWeak: (rawImport >> 8) & 1 != 0,
+                nameOffset: rawImport >> 9,
+                addend: addend
+            )
+        case ImportFormat.addend64:
+            let rawImport = Self.read(UInt64.self, at: importsOffset + Int(index) * 16, in: fixupsBytes)
+            let rawOrdinal = UInt16(truncatingIfNeeded: rawImport)
+            return Import(
+                // Only the top few values of the ordinal are special, so only sign-extend those.
+                libraryOrdinal: rawOrdinal >= 0xFFF0 ? Int(Int16(bitPattern: rawOrdinal)) : Int(rawOrdinal),
+                isWeak: (rawImport >> 16) & 1 != 0,
+                nameOffset: UInt32(truncatingIfNeeded: rawImport >> 32),
+                addend: Self.read(Int64.self, at: importsOffset + Int(index) * 16 + 8, in: fixupsBytes)
+            )
+        default:
+            return nil
+        }
+    }
+}
+
+// MARK: - Chains
+
+extension Mach.ChainedFixups {
+    /// The pointer formats.
+    private enum PointerFormat {
+        /// `DYLD_CHAINED_PTR_ARM64E`
+        static let arm64e: UInt16 = 1
+
+        /// `DYLD_CHAINED_PTR_64`
+        static let pointer64: UInt16 = 2
+
+        /// `DYLD_CHAINED_PTR_64_OFFSET`
+        static let pointer64Offset: UInt16 = 6
+
+        /// `DYLD_CHAINED_PTR_ARM64E_USERLAND`
+        static let arm64eUserland: UInt16 = 9
+
+        /// `DYLD_CHAINED_PTR_ARM64E_USERLAND24`
+        static let arm64eUserland24: UInt16 = 12
+    }
+
+    /// The page start value indicating a page has no fixups (`DYLD_CHAINED_PTR_START_NONE`).
+    private static let pageStartNone: UInt16 = 0xFFFF
+
+    /// The page start flag indicating a page has multiple chains (`DYLD_CHAINED_PTR_START_MULTI`).
+    /// - Note: This is only used by 32-bit pointer formats.
+    private static let pageStartMulti: UInt16 = 0x8000
+
+    /// Decodes a raw chained pointer.
+    /// - Returns: The target and authentication information of the pointer, and the stride count to the next
+    ///   pointer in the chain (or zero if the chain ends). Returns `nil` if the pointer format is unsupported.
+    private static func decode(
+        rawPointer: UInt64, format: UInt16, preferredLoadAddress: UInt64
+    ) -> (target: Fixup.Target, authentication: Fixup.Authentication?, next: UInt64)? {
+        switch format {
+        case PointerFormat.pointer64, PointerFormat.pointer64Offset:
+            let next = (rawPointer >> 51) & 0xFFF
+            guard rawPointer >> 63 == 0 else {
+                return (
+                    .bind(
+                        importIndex: UInt32(rawPointer & 0xFF_FFFF),
+                        addend: Int64((rawPointer >> 24) & 0xFF)
+                    ), nil, next
+                )
+            }
+            let target = rawPointer & 0xF_FFFF_FFFF
+            return (
+                .rebase(
+                    targetOffset: format == PointerFormat.pointer64
+                        ? target &- preferredLoadAddress : target,
+                    high8: UInt8((rawPointer >> 36) & 0xFF)
+                ), nil, next
+            )
+        case PointerFormat.arm64e, PointerFormat.arm64eUserland, PointerFormat.arm64eUserland24:
+            let next = (rawPointer >> 51) & 0x7FF
+            let isAuthenticated = rawPointer >> 63 != 0
+            let isBind = (rawPointer >> 62) & 1 != 0
+            let ordinalMask: UInt64 = format == PointerFormat.arm64eUserland24 ? 0xFF_FFFF : 0xFFFF
+            let authentication =
+                isAuthenticated
+                ? Fixup.Authentication(
+                    key: UInt8((rawPointer >> 49) & 0x3),
+                    diversity: UInt16((rawPointer >> 32) & 0xFFFF),
+                    hasAddressDiversity: (rawPointer >> 48) & 1 != 0
+                ) : nil
+            switch (isAuthenticated, isBind) {
+            case (true, true):
+                return (.bind(importIndex: UInt32(rawPointer & ordinalMask), addend: 0), authentication, next)
+            case (true, false):
+                return (.rebase(targetOffset: rawPointer & 0xFFFF_FFFF, high8: 0), authentication, next)
+            case (false, true):
+                // The addend is a signed 19-bit value.
+                let rawAddend = Int64((rawPointer >> 32) & 0x7FFFF)
+                let addend = (rawAddend << 45) >> 45
+                return (.bind(importIndex: UInt32(rawPointer & ordinalMask), addend: addend), nil, next)
+            case (false, false):
+                let target = rawPointer & 0x7FF_FFFF_FFFF
+                return (
+                    .rebase(
+                        targetOffset: format == PointerFormat.arm64e
+                            ? target &- preferredLoadAddress : target,
+                        high8: UInt8((rawPointer >> 43) & 0xFF)
+                    ), nil, next
+                )
+            }
+        default:
+            return nil
+        }
+    }
+
+    /// The number of bytes each stride in a chain represents for a pointer format.
+    private static func strideSize(forFormat format: UInt16) -> Int {
+        switch format {
+        case PointerFormat.arm64e, PointerFormat.arm64eUserland, PointerFormat.arm64eUserland24: 8
+        default: 4
+        }
+    }
+
+    /// Calls a closure for each fixup in the chains of a segment.
+    /// - Returns: Whether the enumeration should continue.
+    private func forEachFixup(
+        inSegmentAt segmentIndex: Int, in objectBytes: UnsafeRawBufferPointer,
+        _ body: (Fixup) throws -> Bool
+    ) rethrows -> Bool {
+        guard segmentIndex < self.segmentLayouts.count else { return true }
+        let fixupsBytes = UnsafeRawBufferPointer(rebasing: objectBytes[self.range])
+        let startsOffset = Int(Self.read(UInt32.self, at: HeaderOffset.startsOffset, in: fixupsBytes))
+        let segmentCount = Int(Self.read(UInt32.self, at: startsOffset, in: fixupsBytes))
+        guard segmentIndex < segmentCount else { return true }
+        let segmentInfoOffset = Int(
+            Self.read(UInt32.self, at: startsOffset + 4 + segmentIndex * 4, in: fixupsBytes)
+        )
+        guard segmentInfoOffset != 0 else { return true }
+
+        // Read the `dyld_chained_starts_in_segment` structure.
+        let segmentStartsOffset = startsOffset + segmentInfoOffset
+        let pageSize = Int(Self.read(UInt16.self, at: segmentStartsOffset + 4, in: fixupsBytes))
+        let pointerFormat = Self.read(UInt16.self, at: segmentStartsOffset + 6, in: fixupsBytes)
+        let pageCount = Int(Self.read(UInt16.self, at: segmentStartsOffset + 20, in: fixupsBytes))
+        let strideSize = Self.strideSize(forFormat: pointerFormat)
+
+        let segmentLayout = self.segmentLayouts[segmentIndex]
+        guard let segmentFileStart = Int(exactly: segmentLayout.fileOffset), segmentFileStart <= objectBytes.count
+        else { return true }
+        let segmentFileEnd =
+            segmentFileStart + min(Int(clamping: segmentLayout.fileSize), objectBytes.count - segmentFileStart)
+
+        for pageIndex in 0..<pageCount {
+            let pageStart = Self.read(
+                UInt16.self, at: segmentStartsOffset + 22 + pageIndex * 2, in: fixupsBytes
+            )
+            guard pageStart != Self.pageStartNone, pageStart & Self.pageStartMulti == 0 else { continue }
+            var fixupOffset = segmentFileStart + pageIndex * pageSize + Int(pageStart)
+            while fixupOffset + MemoryLayout<UInt64>.size <= segmentFileEnd {
+                let rawPointer = objectBytes.loadUnaligned(fromByteOffset: fixupOffset, as: UInt64.self)
+                guard
+                    let decodedPointer = Self.decode(
+                        rawPointer: rawPointer, format: pointerFormat,
+                        preferredLoadAddress: self.preferredLoadAddress
+                    )
+                else { return true }  // Unsupported pointer formats are skipped.
+                let fixup = Fixup(
+                    segmentIndex: segmentIndex,
+                    segmentOffset: UInt64(fixupOffset - segmentFileStart),
+                    fileOffset: fixupOffset,
+                    target: decodedPointer.target,
+                    authentication: decodedPointer.authentication
+                )
+                guard try body(fixup) else { return false }
+                guard decodedPointer.next != 0 else { break }
+                fixupOffset += Int(decodedPointer.next) * strideSize
+            }
+        }
+        return true
+    }
+
+    /// Calls a closure for each fixup, segment by segment and page by page.
+    /// - Note: The closure returns whether to continue enumerating.
+    /// - Note: Segments using pointer formats other than the 64-bit userland formats are skipped.
+    public func forEachFixup(_ body: (Fixup) throws -> Bool) rethrows {
+        try self.data.withUnsafeBytes { objectBytes in
+            for segmentIndex in self.segmentLayouts.indices {
+                guard try self.forEachFixup(inSegmentAt: segmentIndex, in: objectBytes, body) else { return }
+            }
+        }
+    }
+
+    /// Calls a closure for each fixup in a segment, page by page.
+    /// - Note: The closure returns whether to continue enumerating.
+    public func forEachFixup(inSegmentAt segmentIndex: Int, _ body: (Fixup) throws -> Bool) rethrows {
+        _ = try self.data.withUnsafeBytes { objectBytes in
+            try self.forEachFixup(inSegmentAt: segmentIndex, in: objectBytes, body)
+        }
+    }
+}
+
+// MARK: - Applying
+
+extension Mach.ChainedFixups {
+    /// Applies the fixups of a segment to a buffer containing the segment's file data.
+    /// - Parameters:
+    ///   - segmentIndex: The index of the segment.
+    ///   - buffer: A buffer containing the file data of the segment, which is updated in place.
+    ///   - loadAddress: The address the image is loaded at.
+    ///   - resolver: A closure resolving an import to an address. It is called once per import.
+    /// - Warning: Signed pointers are written unsigned, as signing can only be done in the target process.
+    public func apply(
+        toSegmentAt segmentIndex: Int, buffer: UnsafeMutableRawBufferPointer, loadAddress: UInt64,
+        resolvingImportsWith resolver: (_ import: Import, _ importIndex: UInt32) throws -> UInt64
+    ) rethrows {
+        var resolvedImports: [UInt64?] = Array(repeating: nil, count: self.numberOfReadableImports)
+        try self.data.withUnsafeBytes { objectBytes in
+            let fixupsBytes = UnsafeRawBufferPointer(rebasing: objectBytes[self.range])
+            _ = try self.forEachFixup(inSegmentAt: segmentIndex, in: objectBytes) { fixup in
+                let offset = Int(fixup.segmentOffset)
+                guard offset + MemoryLayout<UInt64>.size <= buffer.count else { return true }
+                let value: UInt64
+                switch fixup.target {
+                case .rebase(let targetOffset, let high8):
+                    value = (loadAddress &+ targetOffset) | (UInt64(high8) << 56)
+                case .bind(let importIndex, let addend):
+                    guard Int(importIndex) < resolvedImports.count,
+                        let `import` = Self.readImport(at: importIndex, in: fixupsBytes)
+                    else { return true }
+                    let importAddress: UInt64
+                    if let resolvedImport = resolvedImports[Int(importIndex)] {
+                        importAddress = resolvedImport
+                    } else {
+                        importAddress = try resolver(`import`, importIndex)
+                        resolvedImports[Int(importIndex)] = importAddress
+                    }
+                    value = importAddress &+ UInt64(bitPattern: addend &+ `import`.addend)
+                }
+                buffer.storeBytes(of: value, toByteOffset: offset, as: UInt64.self)
+                return true
+            }
+        }
+    }
+}
+
+extension Mach.Object {
+    /// The chained fixups of the Mach object, if it has any.
+    public var chainedFixups: Mach.ChainedFixups? {
+        guard let chainedFixupsCommand = self.loadCommands(ofType: Mach.ChainedFixupsCommand.self).first
+        else { return nil }
+        return Mach.ChainedFixups(object: self, fileRange: chainedFixupsCommand.dataRange)
+    }
+}
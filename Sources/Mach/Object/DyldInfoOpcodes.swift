@@ -0,0 +1,199 @@
+import Foundation
+import MachCore
+import MachO
+
+extension Mach.DyldInfoCommand {
+    /// A rebase decoded from the rebase opcode stream.
+    public struct Rebase: Sendable {
+        /// The index of the segment containing the rebased pointer.
+        public let segmentIndex: Int
+
+        /// The offset of the rebased pointer in its segment.
+        public let segmentOffset: UInt64
+
+        /// The type of the rebase.
+        public let type: UInt8
+    }
+
+    /// A bind decoded from one of the bind opcode streams.
+    public struct Bind: Sendable {
+        /// The index of the segment containing the bound pointer.
+        public let segmentIndex: Int
+
+        /// The offset of the bound pointer in its segment.
+        public let segmentOffset: UInt64
+
+        /// The type of the bind.
+        public let type: UInt8
+
+        /// The ordinal of the library the symbol is imported from.
+        /// - Note: Special ordinals (such as for flat lookups) are negative.
+        public let libraryOrdinal: Int
+
+        /// The flags of the symbol.
+        public let symbolFlags: UInt8
+
+        /// The addend of the bind.
+        public let addend: Int64
+
+        /// Whether the bind is weak.
+        public var isWeakImport: Bool { symbolFlags & UInt8(BIND_SYMBOL_FLAGS_WEAK_IMPORT) != 0 }
+    }
+
+    /// A bind opcode stream.
+    public enum BindStream: Sendable {
+        /// The regular bind opcodes.
+        case regular
+
+        /// The weak bind opcodes.
+        case weak
+
+        /// The lazy bind opcodes.
+        case lazy
+    }
+}
+
+extension Mach.DyldInfoCommand {
+    /// Calls a closure for each rebase in the rebase opcode stream of a Mach object.
+    /// - Note: The closure returns whether to continue enumerating.
+    public func forEachRebase(
+        withObject object: some Mach.Object, _ body: (Rebase) -> Bool
+    ) {
+        let pointerSize = UInt64(object.pointerSize)
+        let segmentLayouts = object.segmentLayouts
+        object.withUnsafeBytes(inFileRange: self.rebaseRange) { opcodeBytes in
+            var cursor = LEB128Cursor(bytes: opcodeBytes)
+            var type: UInt8 = 0
+            var segmentIndex = 0
+            var segmentOffset: UInt64 = 0
+
+            /// Emits rebases, stopping at the end of the segment in case of a malformed count.
+            func emit(count: UInt64, skip: UInt64) -> Bool {
+                guard segmentIndex < segmentLayouts.count else { return false }
+                let segmentSize = segmentLayouts[segmentIndex].vmSize
+                for _ in 0..<count {
+                    guard segmentOffset < segmentSize else { return false }
+                    let rebase = Rebase(segmentIndex: segmentIndex, segmentOffset: segmentOffset, type: type)
+                    guard body(rebase) else { return false }
+                    segmentOffset &+= skip &+ pointerSize
+                }
+                return true
+            }
+
+            while !cursor.isAtEnd {
+                let byte = cursor.readByte()
+                let immediate = byte & UInt8(REBASE_IMMEDIATE_MASK)
+                switch Int32(byte & UInt8(REBASE_OPCODE_MASK)) {
+                case REBASE_OPCODE_DONE:
+                    return
+                case REBASE_OPCODE_SET_TYPE_IMM:
+                    type = immediate
+                case REBASE_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB:
+                    segmentIndex = Int(immediate)
+                    segmentOffset = cursor.readULEB128()
+                case REBASE_OPCODE_ADD_ADDR_ULEB:
+                    segmentOffset &+= cursor.readULEB128()
+                case REBASE_OPCODE_ADD_ADDR_IMM_SCALED:
+                    segmentOffset &+= UInt64(immediate) * pointerSize
+                case REBASE_OPCODE_DO_REBASE_IMM_TIMES:
+                    guard emit(count: UInt64(immediate), skip: 0) else { return }
+                case REBASE_OPCODE_DO_REBASE_ULEB_TIMES:
+                    guard emit(count: cursor.readULEB128(), skip: 0) else { return }
+                case REBASE_OPCODE_DO_REBASE_ADD_ADDR_ULEB:
+                    guard emit(count: 1, skip: cursor.readULEB128()) else { return }
+                case REBASE_OPCODE_DO_REBASE_ULEB_TIMES_SKIPPING_ULEB:
+                    let count = cursor.readULEB128()
+                    guard emit(count: count, skip: cursor.readULEB128()) else { return }
+                default:
+                    return  // The opcode is unknown, so the rest of the stream cannot be trusted.
+                }
+            }
+        }
+    }
+
+    /// Calls a closure for each bind in a bind opcode stream of a Mach object.
+    /// - Note: The closure returns whether to continue enumerating. The symbol name buffer passed to it is only
+    ///   valid for the duration of the call.
+    public func forEachBind(
+        in stream: BindStream, withObject object: some Mach.Object,
+        _ body: (_ bind: Bind, _ symbolNameBytes: UnsafeRawBufferPointer) -> Bool
+    ) {
+        let pointerSize = UInt64(object.pointerSize)
+        let segmentLayouts = object.segmentLayouts
+        let streamRange =
+            switch stream {
+            case .regular: self.bindRange
+            case .weak: self.weakBindRange
+            case .lazy: self.lazyBindRange
+            }
+        object.withUnsafeBytes(inFileRange: streamRange) { opcodeBytes in
+            var cursor = LEB128Cursor(bytes: opcodeBytes)
+            var type = UInt8(BIND_TYPE_POINTER)
+            var segmentIndex = 0
+            var segmentOffset: UInt64 = 0
+            var libraryOrdinal = 0
+            var symbolFlags: UInt8 = 0
+            var symbolNameBytes = UnsafeRawBufferPointer(start: nil, count: 0)
+            var addend: Int64 = 0
+
+            /// Emits binds, stopping at the end of the segment in case of a malformed count.
+            func emit(count: UInt64, skip: UInt64) -> Bool {
+                guard segmentIndex < segmentLayouts.count else { return false }
+                let segmentSize = segmentLayouts[segmentIndex].vmSize
+                for _ in 0..<count {
+                    guard segmentOffset < segmentSize else { return false }
+                    let bind = Bind(
+                        segmentIndex: segmentIndex, segmentOffset: segmentOffset, type: type,
+                        libraryOrdinal: libraryOrdinal, symbolFlags: symbolFlags, addend: addend
+                    )
+                    guard body(bind, symbolNameBytes) else { return false }
+                    segmentOffset &+= skip &+ pointerSize
+                }
+                return true
+            }
+
+            while !cursor.isAtEnd {
+                let byte = cursor.readByte()
+                let immediate = byte & UInt8(BIND_IMMEDIATE_MASK)
+                switch Int32(byte & UInt8(BIND_OPCODE_MASK)) {
+                case BIND_OPCODE_DONE:
+                    // The lazy bind stream uses this opcode to separate entries, not to terminate the stream.
+                    guard stream == .lazy else { return }
+                case BIND_OPCODE_SET_DYLIB_ORDINAL_IMM:
+                    libraryOrdinal = Int(immediate)
+                case BIND_OPCODE_SET_DYLIB_ORDINAL_ULEB:
+                    libraryOrdinal = Int(truncatingIfNeeded: cursor.readULEB128())
+                case BIND_OPCODE_SET_DYLIB_SPECIAL_IMM:
+                    // Special ordinals are negative, so the immediate is sign-extended.
+                    libraryOrdinal =
+                        immediate == 0
+                        ? 0 : Int(Int8(bitPattern: UInt8(BIND_OPCODE_MASK) | immediate))
+                case BIND_OPCODE_SET_SYMBOL_TRAILING_FLAGS_IMM:
+                    symbolFlags = immediate
+                    symbolNameBytes = cursor.readCStringBytes()
+                case BIND_OPCODE_SET_TYPE_IMM:
+                    type = immediate
+                case BIND_OPCODE_SET_ADDEND_SLEB:
+                    addend = cursor.readSLEB128()
+                case BIND_OPCODE_SET_SEGMENT_AND_OFFSET_ULEB:
+                    segmentIndex = Int(immediate)
+                    segmentOffset = cursor.readULEB128()
+                case BIND_OPCODE_ADD_ADDR_ULEB:
+                    segmentOffset &+= cursor.readULEB128()
+                case BIND_OPCODE_DO_BIND:
+                    guard emit(count: 1, skip: 0) else { return }
+                case BIND_OPCODE_DO_BIND_ADD_ADDR_ULEB:
+                    guard emit(count: 1, skip: cursor.readULEB128()) else { return }
+                case BIND_OPCODE_DO_BIND_ADD_ADDR_IMM_SCALED:
+                    guard emit(count: 1, skip: UInt64(immediate) * pointerSize) else { return }
+                case BIND_OPCODE_DO_BIND_ULEB_TIMES_SKIPPING_ULEB:
+                    let count = cursor.readULEB128()
+                    guard emit(count: count, skip: cursor.readULEB128()) else { return }
+                default:
+                    // This includes `BIND_OPCODE_THREADED`, which is superseded by chained fixups.
+                    return
+                }
+            }
+        }
+    }
+}
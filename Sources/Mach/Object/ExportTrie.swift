@@ -0,0 +1,270 @@
+import Foundation
+import MachCore
+import MachO
+
+extension Mach {
+    /// The export trie of a Mach object, as referenced by `LC_DYLD_EXPORTS_TRIE` or `LC_DYLD_INFO`.
+    /// - Note: The trie is walked directly over the object's data, and names are never materialized unless requested.
+    public struct ExportTrie: Sendable {
+        /// An exported symbol.
+        public struct Export: Sendable {
+            /// The raw export flags.
+            public let flags: UInt64
+
+            /// The address of the symbol, relative to the start of the image.
+            /// - Note: This is zero for re-exported symbols.
+            public let address: UInt64
+
+            /// The ordinal of the library the symbol is re-exported from, if the symbol is re-exported.
+            public let reexportLibraryOrdinal: UInt64?
+
+            /// The address of the resolver function, relative to the start of the image, if the symbol has one.
+            public let resolverAddress: UInt64?
+
+            /// The range of the re-exported symbol's imported name in the trie, if the symbol is re-exported.
+            internal let importNameRange: Range<Int>?
+
+            /// The kind of the symbol.
+            public var kind: UInt64 { flags & UInt64(EXPORT_SYMBOL_FLAGS_KIND_MASK) }
+
+            /// Whether the symbol is a regular symbol.
+            public var isRegular: Bool { kind == UInt64(EXPORT_SYMBOL_FLAGS_KIND_REGULAR) }
+
+            /// Whether the symbol is thread-local.
+            public var isThreadLocal: Bool { kind == UInt64(EXPORT_SYMBOL_FLAGS_KIND_THREAD_LOCAL) }
+
+            /// Whether the symbol has an absolute address.
+            public var isAbsolute: Bool { kind == UInt64(EXPORT_SYMBOL_FLAGS_KIND_ABSOLUTE) }
+
+            /// Whether the symbol is a weak definition.
+            public var isWeakDefinition: Bool {
+                flags & UInt64(EXPORT_SYMBOL_FLAGS_WEAK_DEFINITION) != 0
+            }
+
+            /// Whether the symbol is re-exported from another library.
+            public var isReexport: Bool { flags & UInt64(EXPORT_SYMBOL_FLAGS_REEXPORT) != 0 }
+
+            /// Whether the symbol is a stub with a resolver function.
+            public var isStubAndResolver: Bool {
+                flags & UInt64(EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER) != 0
+            }
+        }
+
+        /// The raw data of the object containing the trie.
+        private let data: Data
+
+        /// The range of the trie in the object's data.
+        private let range: Range<Int>
+
+        /// Represents the export trie at a file range in a Mach object.
+        public init(object: some Mach.Object, fileRange: Range<Int>) {
+            self.data = object.data
+            self.range = fileRange.clamped(to: 0..<object.data.count)
+        }
+
+        /// Calls a closure with a borrowed view of the trie.
+        private func withUnsafeTrieBytes<ResultType>(
+            _ body: (UnsafeRawBufferPointer) throws -> ResultType
+        ) rethrows -> ResultType {
+            try self.data.withUnsafeBytes {
+                try body(UnsafeRawBufferPointer(rebasing: $0[self.range]))
+            }
+        }
+
+        /// Reads the export information of a node, if the node is terminal.
+        /// - Note: On return, the cursor is positioned at the child count of the node. If the terminal size is out of
+        ///   bounds, the cursor is moved to the end so that the node is treated as missing.
+        private static func readTerminal(_ cursor: inout LEB128Cursor) -> Export? {
+            guard let terminalSize = Int(exactly: cursor.readULEB128()),
+                terminalSize <= cursor.bytes.count - min(cursor.offset, cursor.bytes.count)
+            else {
+                cursor.offset = cursor.bytes.count
+                return nil
+            }
+            let childrenOffset = cursor.offset + terminalSize
+            defer { cursor.offset = childrenOffset }
+            guard terminalSize != 0 else { return nil }
+            let flags = cursor.readULEB128()
+            if flags & UInt64(EXPORT_SYMBOL_FLAGS_REEXPORT) != 0 {
+                let ordinal = cursor.readULEB128()
+                let importNameStart = cursor.offset
+                let importNameLength = cursor.readCStringBytes().count
+                return Export(
+                    flags: flags, address: 0, reexportLibraryOrdinal: ordinal, resolverAddress: nil,
+                    importNameRange: importNameStart..<importNameStart + importNameLength
+                )
+            }
+            let address = cursor.readULEB128()
+            let resolverAddress =
+                flags & UInt64(EXPORT_SYMBOL_FLAGS_STUB_AND_RESOLVER) != 0
+                ? cursor.readULEB128() : nil
+            return Export(
+                flags: flags, address: address, reexportLibraryOrdinal: nil,
+                resolverAddress: resolverAddress, importNameRange: nil
+            )
+        }
+
+        /// Walks down the trie along a byte string.
+        /// - Returns: The offset of the node reached and, if the walk ended in the middle of an edge, the rest of
+        ///   that edge's label. Returns `nil` if no node matches the byte string.
+        private static func descend(
+            _ trie: UnsafeRawBufferPointer, along bytes: UnsafeRawBufferPointer, allowingPartialEdge: Bool
+        ) -> (nodeOffset: Int, edgeRemainder: UnsafeRawBufferPointer)? {
+            var nodeOffset = 0
+            var consumed = 0
+            // Each node takes at least two bytes, so a well-formed walk cannot visit more nodes than this.
+            var remainingSteps = trie.count / 2 + 1
+            while consumed < bytes.count {
+                guard nodeOffset < trie.count, remainingSteps > 0 else { return nil }
+                remainingSteps -= 1
+                var cursor = LEB128Cursor(bytes: trie, offset: nodeOffset)
+                _ = Self.readTerminal(&cursor)
+                let childCount = Int(cursor.readByte())
+                var nextNodeOffset: Int? = nil
+                for _ in 0..<childCount {
+                    let label = cursor.readCStringBytes()
+                    guard let childOffset = Int(exactly: cursor.readULEB128()), childOffset < trie.count else {
+                        return nil
+                    }
+                    let remaining = UnsafeRawBufferPointer(rebasing: bytes[consumed...])
+                    if remaining.starts(with: label) {
+                        consumed += label.count
+                        nextNodeOffset = childOffset
+                        break
+                    }
+                    if allowingPartialEdge, label.starts(with: remaining) {
+                        return (
+                            childOffset,
+                            UnsafeRawBufferPointer(rebasing: label[remaining.count...])
+                        )
+                    }
+                }
+                guard let nextNodeOffset else { return nil }
+                nodeOffset = nextNodeOffset
+            }
+            return (nodeOffset, UnsafeRawBufferPointer(start: nil, count: 0))
+        }
+
+        /// Enumerates the exports below a node in depth-first order.
+        /// - Note: The name buffer is reused across exports, so the name passed to the closure is only valid
+        ///   during the call.
+        private static func enumerate(
+            _ trie: UnsafeRawBufferPointer, from startNodeOffset: Int,
+            namePrefix: UnsafeRawBufferPointer, edgeRemainder: UnsafeRawBufferPointer,
+            _ body: (UnsafeRawBufferPointer, Export) throws -> Bool
+        ) rethrows {
+            var nameBuffer = Array(namePrefix) + Array(edgeRemainder)
+            // Each entry holds a node, the length of its parent's name, and the range of its edge label in the trie.
+            var stack: [(nodeOffset: Int, parentNameLength: Int, labelRange: Range<Int>)] = [
+                (startNodeOffset, nameBuffer.count, 0..<0)
+            ]
+            // Each node takes at least two bytes, so a well-formed walk cannot visit more nodes than this.
+            var remainingSteps = trie.count / 2 + 1
+            while let entry = stack.popLast() {
+                guard entry.nodeOffset < trie.count, remainingSteps > 0 else { continue }
+                remainingSteps -= 1
+                nameBuffer.removeSubrange(entry.parentNameLength...)
+                nameBuffer.append(contentsOf: trie[entry.labelRange])
+                var cursor = LEB128Cursor(bytes: trie, offset: entry.nodeOffset)
+                if let export = Self.readTerminal(&cursor) {
+                    let shouldContinue = try nameBuffer.withUnsafeBytes { try body($0, export) }
+                    guard shouldContinue else { return }
+                }
+                let childCount = Int(cursor.readByte())
+                let firstChildIndex = stack.count
+                for _ in 0..<childCount {
+                    let labelStart = cursor.offset
+                    let labelLength = cursor.readCStringBytes().count
+                    guard let childOffset = Int(exactly: cursor.readULEB128()), childOffset < trie.count else {
+                        continue
+                    }
+                    stack.append((childOffset, nameBuffer.count, labelStart..<labelStart + labelLength))
+                }
+                // Reverse the children so that they are visited in trie order.
+                stack[firstChildIndex...].reverse()
+            }
+        }
+    }
+}
+
+extension Mach.ExportTrie {
+    /// Looks up an exported symbol by name.
+    public func export(named name: String) -> Export? {
+        var name = name
+        return name.withUTF8 { self.export(named: UnsafeRawBufferPointer($0)) }
+    }
+
+    /// Looks up an exported symbol by name, expressed as raw UTF-8 bytes.
+    public func export(named nameBytes: UnsafeRawBufferPointer) -> Export? {
+        self.withUnsafeTrieBytes { trie in
+            guard
+                let destination = Self.descend(trie, along: nameBytes, allowingPartialEdge: false),
+                destination.nodeOffset < trie.count
+            else { return nil }
+            var cursor = LEB128Cursor(bytes: trie, offset: destination.nodeOffset)
+            return Self.readTerminal(&cursor)
+        }
+    }
+
+    /// Calls a closure for each exported symbol, in trie order.
+    /// - Note: The closure returns whether to continue enumerating. The name buffer passed to it is only valid
+    ///   for the duration of the call.
+    public func forEachExport(
+        _ body: (_ nameBytes: UnsafeRawBufferPointer, _ export: Export) throws -> Bool
+    ) rethrows {
+        try self.forEachExport(withPrefix: UnsafeRawBufferPointer(start: nil, count: 0), body)
+    }
+
+    /// Calls a closure for each exported symbol whose name starts with a prefix, in trie order.
+    /// - Note: The closure returns whether to continue enumerating. The name buffer passed to it is only valid
+    ///   for the duration of the call.
+    public func forEachExport(
+        withPrefix prefix: String,
+        _ body: (_ nameBytes: UnsafeRawBufferPointer, _ export: Export) throws -> Bool
+    ) rethrows {
+        var prefix = prefix
+        try prefix.withUTF8 { try self.forEachExport(withPrefix: UnsafeRawBufferPointer($0), body) }
+    }
+
+    /// Calls a closure for each exported symbol whose name starts with a prefix, expressed as raw UTF-8 bytes.
+    /// - Note: The closure returns whether to continue enumerating. The name buffer passed to it is only valid
+    ///   for the duration of the call.
+    public func forEachExport(
+        withPrefix prefixBytes: UnsafeRawBufferPointer,
+        _ body: (_ nameBytes: UnsafeRawBufferPointer, _ export: Export) throws -> Bool
+    ) rethrows {
+        try self.withUnsafeTrieBytes { trie in
+            guard !trie.isEmpty,
+                let destination = Self.descend(trie, along: prefixBytes, allowingPartialEdge: true)
+            else { return }
+            try Self.enumerate(
+                trie, from: destination.nodeOffset, namePrefix: prefixBytes,
+                edgeRemainder: destination.edgeRemainder, body
+            )
+        }
+    }
+
+    /// Gets the name a re-exported symbol is imported under.
+    /// - Note: This returns `nil` if the symbol is not re-exported, or if it is imported under the same name.
+    public func importName(of export: Export) -> String? {
+        guard let importNameRange = export.importNameRange, !importNameRange.isEmpty else { return nil }
+        return self.withUnsafeTrieBytes {
+            String(decoding: $0[importNameRange.clamped(to: 0..<$0.count)], as: UTF8.self)
+        }
+    }
+}
+
+extension Mach.Object {
+    /// The export trie of the Mach object, if it has one.
+    public var exportTrie: Mach.ExportTrie? {
+        if let exportsTrieCommand = self.loadCommands(ofType: Mach.ExportsTrieCommand.self).first {
+            return Mach.ExportTrie(object: self, fileRange: exportsTrieCommand.dataRange)
+        }
+        if let dyldInfoCommand = self.loadCommands(ofType: Mach.DyldInfoCommand.self).first,
+            !dyldInfoCommand.exportRange.isEmpty
+        {
+            return Mach.ExportTrie(object: self, fileRange: dyldInfoCommand.exportRange)
+        }
+        return nil
+    }
+}
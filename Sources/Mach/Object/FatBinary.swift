@@ -4,7 +4,7 @@ import MachCore
 
 extension Mach {
     /// A fat Mach binary.
-    public protocol FatBinary {
+    public protocol FatBinary: Sendable {
         /// A C representation of the fat binary architectures.
         associatedtype CFatArchitectureType: Mach.CFatArchitecture
 
@@ -40,6 +40,14 @@ extension Mach.FatBinary {
     }
 }
 
+extension Mach.FatBinary {
+    /// Initializes a fat binary by memory-mapping the file at a URL.
+    /// - Note: The file is mapped rather than read, so only the pages that are accessed are brought into memory.
+    public init(contentsOf url: URL) throws {
+        try self.init(validating: try Data(contentsOf: url, options: .alwaysMapped))
+    }
+}
+
 extension Mach {
     /// A 32-bit fat Mach binary.
     public struct FatBinary32: Mach.FatBinary {
@@ -121,8 +129,10 @@ extension Mach {
 
 extension Mach.FatBinary {
     /// The magic of the fat binary.
+    /// - Note: This is `nil` if the magic is not a known fat binary magic.
     public var magic: Mach.FatMagic? {
-        Mach.FatMagic(rawValue: self.header.magic)
+        let rawMagic = self.header.magic
+        return Mach.FatMagic.allCases.first { $0.rawValue == rawMagic }
     }
 
     /// Whether the fat binary has swapped endianess.
@@ -150,7 +160,7 @@ extension Mach.FatBinary {
 
 extension Mach {
     /// An architecture in a fat binary.
-    public protocol CFatArchitecture: Sendable {
+    public protocol CFatArchitecture: Mach.ByteSwappable, Sendable {
         associatedtype PointerType: FixedWidthInteger
         var cputype: cpu_type_t { get }
         var cpusubtype: cpu_subtype_t { get }
@@ -164,7 +174,7 @@ extension fat_arch: Mach.CFatArchitecture {}
 extension fat_arch_64: Mach.CFatArchitecture {}
 
 extension Mach {
-    public struct FatArchitecture {
+    public struct FatArchitecture: Sendable {
 
         /// The CPU type of the architecture.
         let cpuType: cpu_type_t
@@ -173,42 +183,52 @@ extension Mach {
         let cpuSubtype: cpu_subtype_t
 
         /// The offset of the architecture's object in the fat binary.
-        let offset: any FixedWidthInteger
+        let offset: UInt64
 
         /// The size of the architecture's object in the fat binary.
-        let size: any FixedWidthInteger
+        let size: UInt64
 
         /// The alignment of the architecture's object in the fat binary.
         let alignment: UInt32
 
-        /// The C representation of the architecture.
-        let cRepresentation: any Mach.CFatArchitecture
-
         /// Initializes a fat architecture from its C representation.
-        fileprivate init(cRepresentation: any Mach.CFatArchitecture, byteSwapped: Bool) {
-            self.cRepresentation = cRepresentation
-            if byteSwapped {
-                self.cpuType = cRepresentation.cputype.byteSwapped
-                self.cpuSubtype = cRepresentation.cpusubtype.byteSwapped
-                self.offset = cRepresentation.offset.byteSwapped
-                self.size = cRepresentation.size.byteSwapped
-                self.alignment = cRepresentation.align.byteSwapped
-            } else {
-                self.cpuType = cRepresentation.cputype
-                self.cpuSubtype = cRepresentation.cpusubtype
-                self.offset = cRepresentation.offset
-                self.size = cRepresentation.size
-                self.alignment = cRepresentation.align
-            }
+        fileprivate init<CFatArchitectureType: Mach.CFatArchitecture>(
+            cRepresentation: CFatArchitectureType, byteSwapped: Bool
+        ) {
+            let hostRepresentation = byteSwapped ? cRepresentation.byteSwapped : cRepresentation
+            self.cpuType = hostRepresentation.cputype
+            self.cpuSubtype = hostRepresentation.cpusubtype
+            self.offset = UInt64(hostRepresentation.offset)
+            self.size = UInt64(hostRepresentation.size)
+            self.alignment = hostRepresentation.align
         }
     }
 }
 
 extension Mach.FatArchitecture {
+    /// The range of the architecture's object in the fat binary.
+    /// - Note: The range saturates instead of overflowing for malformed architectures.
+    internal var fileRange: Range<Int> {
+        let (end, overflow) = self.offset.addingReportingOverflow(self.size)
+        return Int(clamping: self.offset)..<Int(clamping: overflow ? UInt64.max : end)
+    }
+
+    /// Whether the architecture's object lies within data of a given size.
+    internal func fits(inDataOfCount dataCount: Int) -> Bool {
+        let dataSize = UInt64(dataCount)
+        return self.offset <= dataSize && self.size <= dataSize - self.offset
+    }
+
+    /// Gets a view of the architecture's object in a fat binary.
+    /// - Note: The view shares storage with the fat binary's data, so no bytes are copied.
+    internal func objectData(withFatBinary fatBinary: some Mach.FatBinary) -> Data {
+        let fileRange = self.fileRange.clamped(to: 0..<fatBinary.data.count)
+        let start = fatBinary.data.startIndex
+        return fatBinary.data[start + fileRange.lowerBound..<start + fileRange.upperBound]
+    }
+
     public func object(withFatBinary fatBinary: some Mach.FatBinary) -> any Mach.Object {
-        let objectData = fatBinary.data.subdata(
-            in: Int(self.offset)..<Int(Int(self.offset) + Int(self.size))
-        )
+        let objectData = self.objectData(withFatBinary: fatBinary)
         let machMagic = objectData.withUnsafeBytes {
             $0.load(as: Mach.HeaderMagic.RawValue.self)
         }
@@ -218,25 +238,66 @@ extension Mach.FatArchitecture {
         default: Mach.HeaderMagic.unsupported(machMagic: machMagic)
         }
     }
+
+    /// Gets the architecture's object from a fat binary, throwing an error if it is not a valid Mach object.
+    public func validatedObject(withFatBinary fatBinary: some Mach.FatBinary) throws -> any Mach.Object {
+        guard self.fits(inDataOfCount: fatBinary.data.count) else {
+            throw Mach.ObjectError.truncated(
+                expectedSize: self.fileRange.upperBound, actualSize: fatBinary.data.count
+            )
+        }
+        return try Mach.object(validatingData: self.objectData(withFatBinary: fatBinary))
+    }
 }
 
 extension Mach.FatBinary {
     /// The architectures in the fat binary.
+    /// - Note: Architectures past the end of the data are not included.
     public var architectures: [Mach.FatArchitecture] {
-        data.withUnsafeBytes { bufferPointer in
-            return Array(
-                UnsafeBufferPointer(
-                    start: UnsafeRawPointer(bufferPointer.baseAddress!)
-                        .advanced(by: MemoryLayout<fat_header>.size)
-                        .assumingMemoryBound(to: Self.CFatArchitectureType.self),
-                    count: Int(self.numberOfArchitectures))
-            )
-        }.map {
-            Mach.FatArchitecture(
-                cRepresentation: $0,
-                byteSwapped: self.hasSwappedEndianess
+        let byteSwapped = self.hasSwappedEndianess
+        let architectureSize = MemoryLayout<Self.CFatArchitectureType>.size
+        return data.withUnsafeBytes { bufferPointer in
+            let availableCount =
+                max(0, bufferPointer.count - MemoryLayout<fat_header>.size) / architectureSize
+            return (0..<min(Int(self.numberOfArchitectures), availableCount)).map { index in
+                Mach.FatArchitecture(
+                    cRepresentation: bufferPointer.loadUnaligned(
+                        fromByteOffset: MemoryLayout<fat_header>.size + index * architectureSize,
+                        as: Self.CFatArchitectureType.self
+                    ),
+                    byteSwapped: byteSwapped
+                )
+            }
+        }
+    }
+}
+
+extension Mach.FatBinary {
+    /// Initializes a fat binary from its raw data, throwing an error if the data is not a valid fat binary.
+    /// - Note: This checks the magic and that every architecture lies within the data.
+    public init(validating data: Data) throws {
+        self.init(data: data)
+        guard data.count >= MemoryLayout<fat_header>.size else {
+            throw Mach.ObjectError.truncated(
+                expectedSize: MemoryLayout<fat_header>.size, actualSize: data.count
             )
         }
+        let rawMagic = data.withUnsafeBytes { $0.loadUnaligned(as: UInt32.self) }
+        let is64Bit = MemoryLayout<CFatArchitectureType>.size == MemoryLayout<fat_arch_64>.size
+        let expectedMagics = is64Bit ? [FAT_MAGIC_64, FAT_CIGAM_64] : [FAT_MAGIC, FAT_CIGAM]
+        guard expectedMagics.contains(rawMagic) else {
+            throw Mach.ObjectError.unsupportedMagic(rawMagic)
+        }
+        let architecturesEnd =
+            MemoryLayout<fat_header>.size
+            + Int(self.numberOfArchitectures) * MemoryLayout<CFatArchitectureType>.size
+        guard data.count >= architecturesEnd else {
+            throw Mach.ObjectError.truncated(expectedSize: architecturesEnd, actualSize: data.count)
+        }
+        for (index, architecture) in self.architectures.enumerated()
+        where !architecture.fits(inDataOfCount: data.count) {
+            throw Mach.ObjectError.architectureOutOfBounds(index: index)
+        }
     }
 }
 
@@ -263,3 +324,23 @@ extension Mach {
         }
     }
 }
+
+extension Mach {
+    /// Parses a fat binary from its raw data, throwing an error if the data is not a valid fat binary.
+    public static func fatBinary(validatingData data: Data) throws -> any Mach.FatBinary {
+        guard data.count >= MemoryLayout<UInt32>.size else {
+            throw Mach.ObjectError.truncated(expectedSize: MemoryLayout<UInt32>.size, actualSize: data.count)
+        }
+        let fatMagic = data.withUnsafeBytes { $0.loadUnaligned(as: UInt32.self) }
+        switch fatMagic {
+        case FAT_MAGIC, FAT_CIGAM: return try Mach.FatBinary32(validating: data)
+        case FAT_MAGIC_64, FAT_CIGAM_64: return try Mach.FatBinary64(validating: data)
+        default: throw Mach.ObjectError.unsupportedMagic(fatMagic)
+        }
+    }
+
+    /// Memory-maps the fat binary at a URL.
+    public static func fatBinary(contentsOf url: URL) throws -> any Mach.FatBinary {
+        return try Mach.fatBinary(validatingData: try Data(contentsOf: url, options: .alwaysMapped))
+    }
+}
@@ -0,0 +1,67 @@
+import Foundation
+
+/// A cursor for reading LEB128-encoded values from a buffer.
+/// - Note: Reads past the end of the buffer stop at the end of the buffer rather than trapping.
+internal struct LEB128Cursor {
+    /// The buffer being read.
+    let bytes: UnsafeRawBufferPointer
+
+    /// The current offset in the buffer.
+    var offset: Int
+
+    /// Initializes a cursor over a buffer.
+    init(bytes: UnsafeRawBufferPointer, offset: Int = 0) {
+        self.bytes = bytes
+        self.offset = offset
+    }
+
+    /// Whether the cursor has reached the end of the buffer.
+    var isAtEnd: Bool { offset >= bytes.count }
+
+    /// Reads a single byte.
+    mutating func readByte() -> UInt8 {
+        guard !isAtEnd else { return 0 }
+        defer { offset += 1 }
+        return bytes[offset]
+    }
+
+    /// Reads an unsigned LEB128 value.
+    mutating func readULEB128() -> UInt64 {
+        var result: UInt64 = 0
+        var shift: UInt64 = 0
+        while !isAtEnd {
+            let byte = bytes[offset]
+            offset += 1
+            if shift < 64 { result |= UInt64(byte & 0x7F) << shift }
+            shift += 7
+            if byte & 0x80 == 0 { break }
+        }
+        return result
+    }
+
+    /// Reads a signed LEB128 value.
+    mutating func readSLEB128() -> Int64 {
+        var result: Int64 = 0
+        var shift: Int64 = 0
+        var byte: UInt8 = 0
+        while !isAtEnd {
+            byte = bytes[offset]
+            offset += 1
+            if shift < 64 { result |= Int64(byte & 0x7F) << shift }
+            shift += 7
+            if byte & 0x80 == 0 { break }
+        }
+        if shift < 64 && byte & 0x40 != 0 { result |= -(1 << shift) }
+        return result
+    }
+
+    /// Reads a null-terminated string as raw bytes, without creating a `String`.
+    mutating func readCStringBytes() -> UnsafeRawBufferPointer {
+        guard !isAtEnd else { return UnsafeRawBufferPointer(start: nil, count: 0) }
+        let start = offset
+        while !isAtEnd && bytes[offset] != 0 { offset += 1 }
+        let stringBytes = UnsafeRawBufferPointer(rebasing: bytes[start..<offset])
+        if !isAtEnd { offset += 1 }  // Skip the null terminator.
+        return stringBytes
+    }
+}
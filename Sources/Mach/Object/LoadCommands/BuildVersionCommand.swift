@@ -0,0 +1,115 @@
+import Foundation
+import KassHelpers
+import MachCore
+import MachO
+
+extension build_version_command: Mach.CLoadCommand {}
+
+extension Mach {
+    /// A load command containing the platform and versions an image was built for.
+    public struct BuildVersionCommand: LoadCommand {
+        public typealias CLoadCommandType = build_version_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+}
+
+extension Mach.BuildVersionCommand {
+    /// Converts the raw data of a build version command from a byte-swapped object to host byte order.
+    /// - Note: This also converts the tool entries following the build version command.
+    public static func byteSwapped(data: Data) -> Data {
+        var swappedData = Data(data)
+        swappedData.withUnsafeMutableBytes { commandBytes in
+            byteSwapStructure(CLoadCommandType.self, in: commandBytes)
+            var toolOffset = MemoryLayout<CLoadCommandType>.size
+            while toolOffset + MemoryLayout<build_tool_version>.size <= commandBytes.count {
+                byteSwapStructure(
+                    build_tool_version.self,
+                    in: UnsafeMutableRawBufferPointer(rebasing: commandBytes[toolOffset...])
+                )
+                toolOffset += MemoryLayout<build_tool_version>.size
+            }
+        }
+        return swappedData
+    }
+}
+
+extension Mach {
+    /// A platform an image can be built for.
+    public struct Platform: KassHelpers.NamedOptionEnum {
+        /// The name of the platform, if it can be determined.
+        public var name: String?
+
+        /// Represents a platform with an optional name.
+        public init(name: String?, rawValue: UInt32) {
+            self.name = name
+            self.rawValue = rawValue
+        }
+
+        /// The raw value of the platform.
+        public let rawValue: UInt32
+
+        /// All known platforms.
+        public static let allCases: [Self] = [
+            .unknown, .any, .macOS, .iOS, .tvOS, .watchOS, .bridgeOS, .macCatalyst,
+            .iOSSimulator, .tvOSSimulator, .watchOSSimulator, .driverKit,
+        ]
+
+        public static let unknown = Self(name: "unknown", rawValue: UInt32(PLATFORM_UNKNOWN))
+
+        public static let any = Self(name: "any", rawValue: UInt32(PLATFORM_ANY))
+
+        public static let macOS = Self(name: "macOS", rawValue: UInt32(PLATFORM_MACOS))
+
+        public static let iOS = Self(name: "iOS", rawValue: UInt32(PLATFORM_IOS))
+
+        public static let tvOS = Self(name: "tvOS", rawValue: UInt32(PLATFORM_TVOS))
+
+        public static let watchOS = Self(name: "watchOS", rawValue: UInt32(PLATFORM_WATCHOS))
+
+        public static let bridgeOS = Self(name: "bridgeOS", rawValue: UInt32(PLATFORM_BRIDGEOS))
+
+        public static let macCatalyst =
+            Self(name: "macCatalyst", rawValue: UInt32(PLATFORM_MACCATALYST))
+
+        public static let iOSSimulator =
+            Self(name: "iOSSimulator", rawValue: UInt32(PLATFORM_IOSSIMULATOR))
+
+        public static let tvOSSimulator =
+            Self(name: "tvOSSimulator", rawValue: UInt32(PLATFORM_TVOSSIMULATOR))
+
+        public static let watchOSSimulator =
+            Self(name: "watchOSSimulator", rawValue: UInt32(PLATFORM_WATCHOSSIMULATOR))
+
+        public static let driverKit = Self(name: "driverKit", rawValue: UInt32(PLATFORM_DRIVERKIT))
+    }
+}
+
+extension Mach.BuildVersionCommand {
+    /// The platform the image was built for.
+    public var platform: Mach.Platform { Mach.Platform(rawValue: cLoadCommand.platform) }
+
+    /// The minimum OS version the image supports.
+    public var minimumOSVersion: Mach.PackedVersion {
+        Mach.PackedVersion(rawValue: cLoadCommand.minos)
+    }
+
+    /// The SDK version the image was built with.
+    public var sdkVersion: Mach.PackedVersion { Mach.PackedVersion(rawValue: cLoadCommand.sdk) }
+
+    /// The number of tool entries following the load command.
+    public var numberOfTools: UInt32 { cLoadCommand.ntools }
+
+    /// The tools used to build the image.
+    public var tools: [build_tool_version] {
+        data.withUnsafeBytes { pointer in
+            let toolsStart = MemoryLayout<CLoadCommandType>.size
+            let toolSize = MemoryLayout<build_tool_version>.size
+            let availableCount = max(0, pointer.count - toolsStart) / toolSize
+            // Load commands are not necessarily aligned, so each tool is loaded on its own.
+            return (0..<min(Int(self.numberOfTools), availableCount)).map {
+                pointer.loadUnaligned(fromByteOffset: toolsStart + $0 * toolSize, as: build_tool_version.self)
+            }
+        }
+    }
+}
@@ -0,0 +1,47 @@
+import Foundation
+import MachCore
+import MachO
+
+extension dyld_info_command: Mach.CLoadCommand {}
+
+extension Mach {
+    /// A load command containing the compressed dyld information of an image.
+    /// - Note: This represents both `LC_DYLD_INFO` and `LC_DYLD_INFO_ONLY`.
+    public struct DyldInfoCommand: LoadCommand {
+        public typealias CLoadCommandType = dyld_info_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+}
+
+extension Mach.DyldInfoCommand {
+    /// The file range of the rebase opcodes.
+    public var rebaseRange: Range<Int> {
+        let command = cLoadCommand
+        return Int(command.rebase_off)..<Int(command.rebase_off) + Int(command.rebase_size)
+    }
+
+    /// The file range of the bind opcodes.
+    public var bindRange: Range<Int> {
+        let command = cLoadCommand
+        return Int(command.bind_off)..<Int(command.bind_off) + Int(command.bind_size)
+    }
+
+    /// The file range of the weak bind opcodes.
+    public var weakBindRange: Range<Int> {
+        let command = cLoadCommand
+        return Int(command.weak_bind_off)..<Int(command.weak_bind_off) + Int(command.weak_bind_size)
+    }
+
+    /// The file range of the lazy bind opcodes.
+    public var lazyBindRange: Range<Int> {
+        let command = cLoadCommand
+        return Int(command.lazy_bind_off)..<Int(command.lazy_bind_off) + Int(command.lazy_bind_size)
+    }
+
+    /// The file range of the export trie.
+    public var exportRange: Range<Int> {
+        let command = cLoadCommand
+        return Int(command.export_off)..<Int(command.export_off) + Int(command.export_size)
+    }
+}
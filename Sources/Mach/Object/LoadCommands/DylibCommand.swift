@@ -0,0 +1,48 @@
+import Foundation
+import MachCore
+import MachO
+
+extension dylib_command: Mach.CLoadCommand {}
+
+extension Mach {
+    /// A load command referencing a dynamic library.
+    /// - Note: This represents `LC_LOAD_DYLIB` and its variants, as well as `LC_ID_DYLIB`.
+    public struct DylibCommand: LoadCommand {
+        public typealias CLoadCommandType = dylib_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+}
+
+extension Mach.DylibCommand {
+    /// The install name of the library.
+    public var name: String { string(atCommandOffset: cLoadCommand.dylib.name.offset) }
+
+    /// The build timestamp of the library.
+    public var timestamp: UInt32 { cLoadCommand.dylib.timestamp }
+
+    /// The current version of the library.
+    public var currentVersion: Mach.PackedVersion {
+        Mach.PackedVersion(rawValue: cLoadCommand.dylib.current_version)
+    }
+
+    /// The compatibility version of the library.
+    public var compatibilityVersion: Mach.PackedVersion {
+        Mach.PackedVersion(rawValue: cLoadCommand.dylib.compatibility_version)
+    }
+
+    /// Whether the library is weakly linked.
+    public var isWeak: Bool { type == UInt32(LC_LOAD_WEAK_DYLIB) }
+
+    /// Whether the library is re-exported.
+    public var isReexported: Bool { type == UInt32(LC_REEXPORT_DYLIB) }
+
+    /// Whether the library is lazily loaded.
+    public var isLazy: Bool { type == UInt32(LC_LAZY_LOAD_DYLIB) }
+
+    /// Whether the library is an upward dependency.
+    public var isUpward: Bool { type == UInt32(LC_LOAD_UPWARD_DYLIB) }
+
+    /// Whether this load command identifies the object itself as a library.
+    public var isIdentity: Bool { type == UInt32(LC_ID_DYLIB) }
+}
@@ -0,0 +1,58 @@
+import Foundation
+import MachCore
+import MachO
+
+extension dysymtab_command: Mach.CLoadCommand {}
+
+extension Mach {
+    /// A dynamic symbol table load command.
+    public struct DynamicSymbolTableCommand: LoadCommand {
+        public typealias CLoadCommandType = dysymtab_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+}
+
+extension Mach.DynamicSymbolTableCommand {
+    /// Builds a range of symbol indices, saturating instead of overflowing for malformed objects.
+    private static func indices(startingAt start: UInt32, count: UInt32) -> Range<UInt32> {
+        let (end, overflow) = start.addingReportingOverflow(count)
+        return start..<(overflow ? UInt32.max : end)
+    }
+
+    /// The range of indices of the local symbols in the symbol table.
+    public var localSymbolIndices: Range<UInt32> {
+        let command = cLoadCommand
+        return Self.indices(startingAt: command.ilocalsym, count: command.nlocalsym)
+    }
+
+    /// The range of indices of the externally-defined symbols in the symbol table.
+    public var externallyDefinedSymbolIndices: Range<UInt32> {
+        let command = cLoadCommand
+        return Self.indices(startingAt: command.iextdefsym, count: command.nextdefsym)
+    }
+
+    /// The range of indices of the undefined symbols in the symbol table.
+    public var undefinedSymbolIndices: Range<UInt32> {
+        let command = cLoadCommand
+        return Self.indices(startingAt: command.iundefsym, count: command.nundefsym)
+    }
+
+    /// The file offset of the indirect symbol table.
+    public var indirectSymbolTableOffset: UInt32 { cLoadCommand.indirectsymoff }
+
+    /// The number of entries in the indirect symbol table.
+    public var numberOfIndirectSymbols: UInt32 { cLoadCommand.nindirectsyms }
+
+    /// The file offset of the external relocation entries.
+    public var externalRelocationOffset: UInt32 { cLoadCommand.extreloff }
+
+    /// The number of external relocation entries.
+    public var numberOfExternalRelocations: UInt32 { cLoadCommand.nextrel }
+
+    /// The file offset of the local relocation entries.
+    public var localRelocationOffset: UInt32 { cLoadCommand.locreloff }
+
+    /// The number of local relocation entries.
+    public var numberOfLocalRelocations: UInt32 { cLoadCommand.nlocrel }
+}
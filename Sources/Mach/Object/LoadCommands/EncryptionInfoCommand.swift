@@ -0,0 +1,28 @@
+import Foundation
+import MachCore
+import MachO
+
+extension encryption_info_command_64: Mach.CLoadCommand {}
+
+extension Mach {
+    /// A load command describing the encrypted range of a 64-bit image.
+    public struct EncryptionInfo64Command: LoadCommand {
+        public typealias CLoadCommandType = encryption_info_command_64
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+}
+
+extension Mach.EncryptionInfo64Command {
+    /// The file range of the encrypted data.
+    public var encryptedRange: Range<Int> {
+        let command = cLoadCommand
+        return Int(command.cryptoff)..<Int(command.cryptoff) + Int(command.cryptsize)
+    }
+
+    /// The encryption system used, or zero if the image is not encrypted.
+    public var encryptionID: UInt32 { cLoadCommand.cryptid }
+
+    /// Whether the image is encrypted.
+    public var isEncrypted: Bool { encryptionID != 0 }
+}
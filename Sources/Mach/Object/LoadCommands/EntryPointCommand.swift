@@ -0,0 +1,22 @@
+import Foundation
+import MachCore
+import MachO
+
+extension entry_point_command: Mach.CLoadCommand {}
+
+extension Mach {
+    /// A load command containing the entry point of a main executable.
+    public struct EntryPointCommand: LoadCommand {
+        public typealias CLoadCommandType = entry_point_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+}
+
+extension Mach.EntryPointCommand {
+    /// The file offset of the entry point, relative to the start of the `__TEXT` segment.
+    public var entryOffset: UInt64 { cLoadCommand.entryoff }
+
+    /// The initial stack size, if not zero.
+    public var stackSize: UInt64 { cLoadCommand.stacksize }
+}
@@ -0,0 +1,85 @@
+import Foundation
+import MachCore
+import MachO
+
+extension linkedit_data_command: Mach.CLoadCommand {}
+
+extension Mach {
+    /// A load command referencing a blob of data in the `__LINKEDIT` segment.
+    public protocol LinkeditDataCommand: Mach.LoadCommand
+    where CLoadCommandType == linkedit_data_command {}
+}
+
+extension Mach.LinkeditDataCommand {
+    /// The file offset of the data.
+    public var dataOffset: UInt32 { cLoadCommand.dataoff }
+
+    /// The size of the data.
+    public var dataSize: UInt32 { cLoadCommand.datasize }
+
+    /// The file range of the data.
+    public var dataRange: Range<Int> { Int(dataOffset)..<Int(dataOffset) + Int(dataSize) }
+
+    /// Gets the data referenced by this load command from a Mach object.
+    public func linkeditData(withObject object: some Mach.Object) -> Data {
+        object.withUnsafeBytes(inFileRange: dataRange) { Data($0) }
+    }
+
+    /// Calls a closure with a borrowed view of the data referenced by this load command in a Mach object.
+    /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+    public func withUnsafeLinkeditBytes<ResultType>(
+        withObject object: some Mach.Object,
+        _ body: (UnsafeRawBufferPointer) throws -> ResultType
+    ) rethrows -> ResultType {
+        try object.withUnsafeBytes(inFileRange: dataRange, body)
+    }
+}
+
+extension Mach {
+    /// A load command referencing the code signature of an image.
+    public struct CodeSignatureCommand: LinkeditDataCommand {
+        public typealias CLoadCommandType = linkedit_data_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+
+    /// A load command referencing the function starts of an image.
+    public struct FunctionStartsCommand: LinkeditDataCommand {
+        public typealias CLoadCommandType = linkedit_data_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+
+    /// A load command referencing the chained fixups of an image.
+    public struct ChainedFixupsCommand: LinkeditDataCommand {
+        public typealias CLoadCommandType = linkedit_data_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+
+    /// A load command referencing the export trie of an image.
+    public struct ExportsTrieCommand: LinkeditDataCommand {
+        public typealias CLoadCommandType = linkedit_data_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+}
+
+extension Mach.FunctionStartsCommand {
+    /// Gets the offsets of the function starts, relative to the start of the `__TEXT` segment.
+    /// - Note: The function starts are stored as a list of ULEB128-encoded deltas, terminated by a zero delta.
+    public func functionStartOffsets(withObject object: some Mach.Object) -> [UInt64] {
+        self.withUnsafeLinkeditBytes(withObject: object) { linkeditBytes in
+            var offsets: [UInt64] = []
+            var cursor = LEB128Cursor(bytes: linkeditBytes)
+            var currentOffset: UInt64 = 0
+            while !cursor.isAtEnd {
+                let delta = cursor.readULEB128()
+                guard delta != 0 else { break }
+                currentOffset += delta
+                offsets.append(currentOffset)
+            }
+            return offsets
+        }
+    }
+}
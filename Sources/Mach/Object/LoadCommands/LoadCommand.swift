@@ -4,7 +4,7 @@ import MachO
 
 extension Mach {
     /// A C representation of a load command.
-    public protocol CLoadCommand: Sendable {
+    public protocol CLoadCommand: Mach.ByteSwappable, Sendable {
         /// The type of the load command.
         var cmd: UInt32 { get }
 
@@ -31,6 +31,19 @@ extension Mach {
 
         /// Initializes a load command from a pointer to its C representation.
         init(commandPointer: UnsafeMutablePointer<CLoadCommandType>)
+
+        /// Converts the raw data of a load command from a byte-swapped object to host byte order.
+        static func byteSwapped(data: Data) -> Data
+    }
+}
+
+extension Mach.LoadCommand {
+    public static func byteSwapped(data: Data) -> Data {
+        var swappedData = Data(data)
+        swappedData.withUnsafeMutableBytes {
+            byteSwapStructure(CLoadCommandType.self, in: $0)
+        }
+        return swappedData
     }
 }
 
@@ -63,88 +76,213 @@ extension Mach {
     }
 }
 
-private let loadCommandTypeMap: [UInt32: any Mach.LoadCommand.Type] = [
-    // Add known load command types here as needed.
-    UInt32(LC_SEGMENT): Mach.Segment32Command.self,
-    UInt32(LC_SEGMENT_64): Mach.Segment64Command.self,
-]
+extension Mach {
+    /// Gets the load command type used to decode a raw load command type.
+    /// - Note: This is a `switch` over constant raw values, so it compiles to a constant-time jump table.
+    internal static func loadCommandType(forRawType rawType: UInt32) -> any Mach.LoadCommand.Type {
+        switch rawType {
+        // Add known load command types here as needed.
+        case UInt32(LC_SEGMENT): Mach.Segment32Command.self
+        case UInt32(LC_SEGMENT_64): Mach.Segment64Command.self
+        case UInt32(LC_SYMTAB): Mach.SymbolTableCommand.self
+        case UInt32(LC_DYSYMTAB): Mach.DynamicSymbolTableCommand.self
+        case UInt32(LC_DYLD_INFO), UInt32(LC_DYLD_INFO_ONLY): Mach.DyldInfoCommand.self
+        case UInt32(LC_DYLD_CHAINED_FIXUPS): Mach.ChainedFixupsCommand.self
+        case UInt32(LC_DYLD_EXPORTS_TRIE): Mach.ExportsTrieCommand.self
+        case UInt32(LC_CODE_SIGNATURE): Mach.CodeSignatureCommand.self
+        case UInt32(LC_FUNCTION_STARTS): Mach.FunctionStartsCommand.self
+        case UInt32(LC_LOAD_DYLIB), UInt32(LC_LOAD_WEAK_DYLIB), UInt32(LC_REEXPORT_DYLIB),
+            UInt32(LC_LAZY_LOAD_DYLIB), UInt32(LC_LOAD_UPWARD_DYLIB), UInt32(LC_ID_DYLIB):
+            Mach.DylibCommand.self
+        case UInt32(LC_UUID): Mach.UUIDCommand.self
+        case UInt32(LC_BUILD_VERSION): Mach.BuildVersionCommand.self
+        case UInt32(LC_MAIN): Mach.EntryPointCommand.self
+        case UInt32(LC_ENCRYPTION_INFO_64): Mach.EncryptionInfo64Command.self
+        default: Mach.UnknownLoadCommand.self
+        }
+    }
+}
+
+extension Mach.LoadCommand {
+    /// Reads a string stored inside the load command at an offset from the start of the load command.
+    /// - Note: This is used for `lc_str` fields, which store an offset to a null-terminated string.
+    internal func string(atCommandOffset offset: UInt32) -> String {
+        data.withUnsafeBytes { commandBytes in
+            guard Int(offset) < commandBytes.count else { return "" }
+            let stringBytes = commandBytes[Int(offset)...].prefix { $0 != 0 }
+            return String(decoding: stringBytes, as: UTF8.self)
+        }
+    }
+}
 
 extension Mach {
-    /// An iterator over the load commands in a Mach object.
-    fileprivate struct LoadCommandIterator<ObjectCHeaderType: Mach.CHeader>: IteratorProtocol {
+    /// A lazily-decoded collection of the load commands in a Mach object.
+    /// - Note: Load commands are only decoded when they are accessed, and each one shares the storage of the object's data.
+    public struct LoadCommands<ObjectType: Mach.Object>: Collection {
+        /// A position of a load command in the collection.
+        public struct Index: Comparable {
+            /// The offset of the load command in the object's data.
+            fileprivate let offset: Int
+
+            /// The ordinal of the load command in the object.
+            fileprivate let ordinal: Int
+
+            public static func == (lhs: Self, rhs: Self) -> Bool { lhs.ordinal == rhs.ordinal }
+            public static func < (lhs: Self, rhs: Self) -> Bool { lhs.ordinal < rhs.ordinal }
+        }
+
         /// The element type.
         public typealias Element = any Mach.LoadCommand
 
-        /// The count of the load commands.
-        private let count: Int
+        /// The object containing the load commands.
+        public let object: ObjectType
 
-        /// The current index.
-        private var index: Int = 0
+        /// The number of load commands advertised in the object header.
+        private let advertisedCount: Int
 
-        /// The object being iterated over.
-        private let object: any Mach.Object<ObjectCHeaderType>
+        /// Whether the object has swapped endianess.
+        private let isSwapped: Bool
 
-        /// Initializes an iterator with a Mach object.
-        init(object: any Mach.Object<ObjectCHeaderType>) {
-            // Initialize the iterator with the object's load commands.
+        /// Represents the load commands in a Mach object.
+        public init(object: ObjectType) {
             self.object = object
-            self.count = Int(object.header.ncmds)
+            self.advertisedCount = Int(object.header.ncmds)
+            self.isSwapped = object.hasSwappedEndianess
         }
 
-        /// The current offset in the object's data.
-        private var offset: Int = MemoryLayout<ObjectCHeaderType>.size
+        public var startIndex: Index {
+            self.validated(Index(offset: MemoryLayout<ObjectType.CHeaderType>.size, ordinal: 0))
+        }
 
-        /// Deserializes a load command from a pointer.
-        private static func deserialize<LoadCommandType: Mach.LoadCommand>(
-            type: LoadCommandType.Type,
-            fromPointer commandPointer: UnsafeMutablePointer<load_command>,
-            withObject object: any Mach.Object
-        ) -> LoadCommandType {
-            commandPointer.withMemoryRebound(to: type.CLoadCommandType, capacity: 1) {
-                LoadCommandType.init(commandPointer: $0)
+        public var endIndex: Index { Index(offset: self.object.data.count, ordinal: self.advertisedCount) }
+
+        public func index(after position: Index) -> Index {
+            let commandSize = Int(self.rawLoadCommand(at: position.offset).cmdsize)
+            return self.validated(
+                Index(offset: position.offset + commandSize, ordinal: position.ordinal + 1)
+            )
+        }
+
+        public subscript(position: Index) -> Element {
+            let rawCommand = self.rawLoadCommand(at: position.offset)
+            return self.decode(
+                type: Mach.loadCommandType(forRawType: rawCommand.cmd),
+                at: position.offset, size: Int(rawCommand.cmdsize)
+            )
+        }
+
+        /// The raw type of the load command at a position.
+        /// - Note: This does not decode the load command.
+        public func rawType(at position: Index) -> UInt32 {
+            self.rawLoadCommand(at: position.offset).cmd
+        }
+
+        /// Reads the generic load command structure at an offset in the object's data, in host byte order.
+        fileprivate func rawLoadCommand(at offset: Int) -> load_command {
+            let rawCommand = self.object.withUnsafeBytes {
+                $0.loadUnaligned(fromByteOffset: offset, as: load_command.self)
             }
+            return self.isSwapped ? rawCommand.byteSwapped : rawCommand
         }
 
-        /// Advances to the next load command and returns it, or `nil` if there are no more load commands.
-        public mutating func next() -> Element? {
-            guard self.index < self.count else { return nil }
+        /// Clamps an index to the end index if it does not point to a complete load command.
+        /// - Note: This protects against malformed objects advertising more load commands than they contain.
+        private func validated(_ position: Index) -> Index {
+            guard position.ordinal < self.advertisedCount else { return self.endIndex }
+            let dataCount = self.object.data.count
+            guard position.offset + MemoryLayout<load_command>.size <= dataCount else {
+                return self.endIndex
+            }
+            let commandSize = Int(self.rawLoadCommand(at: position.offset).cmdsize)
+            guard commandSize >= MemoryLayout<load_command>.size,
+                position.offset + commandSize <= dataCount
+            else { return self.endIndex }
+            return position
+        }
 
-            // Create a pointer to the current load command.
-            let commandPointer = UnsafeMutableRawPointer(
-                mutating: (self.object.data as NSData).bytes
-            ).advanced(by: offset)
-                .bindMemory(to: load_command.self, capacity: 1)
+        /// Decodes a load command of a given type at an offset in the object's data.
+        /// - Note: For native objects, the load command shares the storage of the object's data instead of copying it.
+        ///   For swapped objects, the load command is copied and converted to host byte order.
+        fileprivate func decode<LoadCommandType: Mach.LoadCommand>(
+            type: LoadCommandType.Type, at offset: Int, size: Int
+        ) -> LoadCommandType {
+            let start = self.object.data.startIndex + offset
+            let commandData = self.object.data[start..<start + size]
+            guard self.isSwapped else { return LoadCommandType(data: commandData) }
+            return LoadCommandType(data: LoadCommandType.byteSwapped(data: commandData))
+        }
+    }
+}
 
-            // Determine the load command type.
-            let loadCommandType =
-                loadCommandTypeMap[commandPointer.pointee.cmd]
-                ?? Mach.UnknownLoadCommand.self
+extension Mach {
+    /// A lazily-decoded sequence of the load commands of a specific type in a Mach object.
+    /// - Note: Only load commands of the given type are decoded, and no existential boxes are created.
+    public struct TypedLoadCommands<ObjectType: Mach.Object, LoadCommandType: Mach.LoadCommand>:
+        Sequence
+    {
+        /// An iterator over the load commands of a specific type.
+        public struct Iterator: IteratorProtocol {
+            /// The load commands being iterated over.
+            fileprivate let loadCommands: Mach.LoadCommands<ObjectType>
 
-            // Deserialize the load command.
-            let loadCommand =
-                Self.deserialize(
-                    type: loadCommandType,
-                    fromPointer: commandPointer,
-                    withObject: object
-                )
+            /// The current position.
+            fileprivate var position: Mach.LoadCommands<ObjectType>.Index
 
-            // Advance the offset and index.
-            offset += Int(loadCommand.size)
-            index += 1
+            public mutating func next() -> LoadCommandType? {
+                while self.position != self.loadCommands.endIndex {
+                    let current = self.position
+                    self.position = self.loadCommands.index(after: current)
+                    let rawCommand = self.loadCommands.rawLoadCommand(at: current.offset)
+                    guard
+                        Mach.loadCommandType(forRawType: rawCommand.cmd) == LoadCommandType.self
+                    else { continue }
+                    return self.loadCommands.decode(
+                        type: LoadCommandType.self,
+                        at: current.offset, size: Int(rawCommand.cmdsize)
+                    )
+                }
+                return nil
+            }
+        }
+
+        /// The load commands to filter.
+        private let loadCommands: Mach.LoadCommands<ObjectType>
+
+        /// Represents the load commands of a specific type in a Mach object.
+        public init(object: ObjectType, type: LoadCommandType.Type) {
+            self.loadCommands = Mach.LoadCommands(object: object)
+        }
+
+        public func makeIterator() -> Iterator {
+            Iterator(loadCommands: self.loadCommands, position: self.loadCommands.startIndex)
+        }
 
-            return loadCommand
+        /// The first load command of the type, if the object has one.
+        public var first: LoadCommandType? {
+            var iterator = self.makeIterator()
+            return iterator.next()
         }
     }
 }
 
 extension Mach.Object {
     /// The load commands contained in the Mach object.
+    /// - Note: This decodes every load command up front. Use ``lazyLoadCommands`` to decode them as they are accessed.
     public var loadCommands: [any Mach.LoadCommand] {
-        var commands: [any Mach.LoadCommand] = []
-        var iterator = Mach.LoadCommandIterator(object: self)
-        while let command = iterator.next() {
-            commands.append(command)
-        }
-        return commands
+        Array(self.lazyLoadCommands)
+    }
+
+    /// The load commands contained in the Mach object.
+    /// - Note: The load commands are decoded lazily as they are accessed.
+    public var lazyLoadCommands: Mach.LoadCommands<Self> {
+        Mach.LoadCommands(object: self)
+    }
+
+    /// The load commands of a specific type contained in the Mach object.
+    /// - Note: The load commands are decoded lazily as they are accessed.
+    public func loadCommands<LoadCommandType: Mach.LoadCommand>(
+        ofType type: LoadCommandType.Type
+    ) -> Mach.TypedLoadCommands<Self, LoadCommandType> {
+        Mach.TypedLoadCommands(object: self, type: type)
     }
 }
@@ -36,6 +36,12 @@ extension Mach {
         /// The VM buffer of the segment.
         var vmBuffer: UnsafeRawBufferPointer { get }
 
+        /// The VM address of the segment.
+        var vmAddress: CLoadCommandType.PointerType { get }
+
+        /// The VM size of the segment.
+        var vmSize: CLoadCommandType.PointerType { get }
+
         /// The file offset of the segment.
         var fileOffset: CLoadCommandType.PointerType { get }
 
@@ -79,6 +85,18 @@ extension Mach.SegmentCommand {
         )
     }
 
+    public var vmAddress: CLoadCommandType.PointerType {
+        data.withUnsafeBytes {
+            $0.load(as: CLoadCommandType.self).vmaddr
+        }
+    }
+
+    public var vmSize: CLoadCommandType.PointerType {
+        data.withUnsafeBytes {
+            $0.load(as: CLoadCommandType.self).vmsize
+        }
+    }
+
     public var fileOffset: CLoadCommandType.PointerType {
         data.withUnsafeBytes {
             $0.load(as: CLoadCommandType.self).fileoff
@@ -120,6 +138,26 @@ extension Mach.SegmentCommand {
     }
 }
 
+extension Mach.SegmentCommand {
+    /// Converts the raw data of a segment command from a byte-swapped object to host byte order.
+    /// - Note: This also converts the sections following the segment command.
+    public static func byteSwapped(data: Data) -> Data {
+        var swappedData = Data(data)
+        swappedData.withUnsafeMutableBytes { commandBytes in
+            byteSwapStructure(CLoadCommandType.self, in: commandBytes)
+            var sectionOffset = MemoryLayout<CLoadCommandType>.size
+            while sectionOffset + MemoryLayout<CSectionType>.size <= commandBytes.count {
+                byteSwapStructure(
+                    CSectionType.self,
+                    in: UnsafeMutableRawBufferPointer(rebasing: commandBytes[sectionOffset...])
+                )
+                sectionOffset += MemoryLayout<CSectionType>.size
+            }
+        }
+        return swappedData
+    }
+}
+
 extension Mach {
     /// A 32-bit segment load command.
     public struct Segment32Command: SegmentCommand {
@@ -142,7 +180,7 @@ extension Mach {
 
 extension Mach {
     /// A section in a segment.
-    public protocol Section<PointerType>: Sendable {
+    public protocol Section<PointerType>: Mach.ByteSwappable, Sendable {
         associatedtype PointerType: UnsignedInteger
         var sectname: Mach.CNameString { get }
         var segname: Mach.CNameString { get }
@@ -184,34 +222,122 @@ extension Mach.SegmentCommand {
     /// The sections in the segment.
     public var sections: [CSectionType] {
         data.withUnsafeBytes { pointer in
-            Array(
-                UnsafeBufferPointer(
-                    start: pointer.baseAddress!
-                        .advanced(by: MemoryLayout<CLoadCommandType>.size)
-                        .assumingMemoryBound(to: CSectionType.self),
-                    count: Int(self.numberOfSections)
-                )
-            )
+            let sectionsStart = MemoryLayout<CLoadCommandType>.size
+            let sectionSize = MemoryLayout<CSectionType>.size
+            let availableCount = max(0, pointer.count - sectionsStart) / sectionSize
+            // Load commands are not necessarily aligned, so each section is loaded on its own.
+            return (0..<min(Int(self.numberOfSections), availableCount)).map {
+                pointer.loadUnaligned(fromByteOffset: sectionsStart + $0 * sectionSize, as: CSectionType.self)
+            }
         }
     }
 }
 
 // MARK: - File Data Helpers
 
+extension Mach {
+    /// The range of the bytes at an offset in a Mach object, clamped to the object's data.
+    /// - Note: Offsets and sizes are read from the object, so they are widened and checked for overflow rather than
+    ///   trusted. A range that starts past the end of the data is empty.
+    internal static func fileRange(
+        offset: some BinaryInteger, size: some BinaryInteger, inDataOfCount dataCount: Int
+    ) -> Range<Int> {
+        let (unclampedEnd, overflow) = Int(clamping: offset).addingReportingOverflow(Int(clamping: size))
+        let end = overflow ? dataCount : min(unclampedEnd, dataCount)
+        return min(Int(clamping: offset), end)..<end
+    }
+}
+
 extension Mach.SegmentCommand {
     /// Gets the file data for this segment from a Mach object.
     public func fileData(withObject object: any Mach.Object) -> Data {
-        return object.data.subdata(
-            in: Int(fileOffset)..<Int(fileOffset + fileSize)
-        )
+        return object.withUnsafeBytes(
+            inFileRange: Mach.fileRange(offset: fileOffset, size: fileSize, inDataOfCount: object.data.count)
+        ) { Data($0) }
     }
 }
 
 extension Mach.Section {
     /// Gets the file data for this section from a Mach object.
     public func fileData(withObject object: any Mach.Object) -> Data {
-        return object.data.subdata(
-            in: Int(fileOffset)..<Int(PointerType(fileOffset) + size)
+        return object.withUnsafeBytes(
+            inFileRange: Mach.fileRange(offset: fileOffset, size: size, inDataOfCount: object.data.count)
+        ) { Data($0) }
+    }
+}
+
+extension Mach.SegmentCommand {
+    /// Calls a closure with a borrowed view of the file data for this segment from a Mach object.
+    /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+    public func withUnsafeFileBytes<ResultType>(
+        withObject object: some Mach.Object,
+        _ body: (UnsafeRawBufferPointer) throws -> ResultType
+    ) rethrows -> ResultType {
+        try object.withUnsafeBytes(
+            inFileRange: Mach.fileRange(offset: fileOffset, size: fileSize, inDataOfCount: object.data.count), body
         )
     }
 }
+
+extension Mach.Section {
+    /// Calls a closure with a borrowed view of the file data for this section from a Mach object.
+    /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+    public func withUnsafeFileBytes<ResultType>(
+        withObject object: some Mach.Object,
+        _ body: (UnsafeRawBufferPointer) throws -> ResultType
+    ) rethrows -> ResultType {
+        try object.withUnsafeBytes(
+            inFileRange: Mach.fileRange(offset: fileOffset, size: size, inDataOfCount: object.data.count), body
+        )
+    }
+}
+
+// MARK: - Segment Layouts
+
+extension Mach {
+    /// The layout of a segment in a Mach object, independent of the object's pointer width.
+    internal struct SegmentLayout: Sendable {
+        /// The VM address of the segment.
+        let vmAddress: UInt64
+
+        /// The VM size of the segment.
+        let vmSize: UInt64
+
+        /// The file offset of the segment.
+        let fileOffset: UInt64
+
+        /// The file size of the segment.
+        let fileSize: UInt64
+
+        /// Creates a segment layout from a segment command.
+        init(_ segment: some Mach.SegmentCommand) {
+            self.vmAddress = UInt64(segment.vmAddress)
+            self.vmSize = UInt64(segment.vmSize)
+            self.fileOffset = UInt64(segment.fileOffset)
+            self.fileSize = UInt64(segment.fileSize)
+        }
+    }
+}
+
+extension Mach.Object {
+    /// The layouts of the segments in the object, in load command order.
+    internal var segmentLayouts: [Mach.SegmentLayout] {
+        self.lazyLoadCommands.compactMap { loadCommand in
+            switch loadCommand {
+            case let segment as Mach.Segment64Command: Mach.SegmentLayout(segment)
+            case let segment as Mach.Segment32Command: Mach.SegmentLayout(segment)
+            default: nil
+            }
+        }
+    }
+
+    /// The preferred load address of the object, which is the VM address of the segment mapping the start of the file.
+    internal var preferredLoadAddress: UInt64 {
+        self.segmentLayouts.first { $0.fileOffset == 0 && $0.fileSize != 0 }?.vmAddress ?? 0
+    }
+
+    /// The size of a pointer in the object.
+    internal var pointerSize: Int {
+        MemoryLayout<CHeaderType>.size == MemoryLayout<mach_header_64>.size ? 8 : 4
+    }
+}
@@ -0,0 +1,28 @@
+import Foundation
+import MachCore
+import MachO
+
+extension symtab_command: Mach.CLoadCommand {}
+
+extension Mach {
+    /// A symbol table load command.
+    public struct SymbolTableCommand: LoadCommand {
+        public typealias CLoadCommandType = symtab_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+}
+
+extension Mach.SymbolTableCommand {
+    /// The file offset of the symbol table.
+    public var symbolTableOffset: UInt32 { cLoadCommand.symoff }
+
+    /// The number of symbols in the symbol table.
+    public var numberOfSymbols: UInt32 { cLoadCommand.nsyms }
+
+    /// The file offset of the string table.
+    public var stringTableOffset: UInt32 { cLoadCommand.stroff }
+
+    /// The size of the string table.
+    public var stringTableSize: UInt32 { cLoadCommand.strsize }
+}
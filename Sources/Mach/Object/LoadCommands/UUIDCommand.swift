@@ -0,0 +1,19 @@
+import Foundation
+import MachCore
+import MachO
+
+extension uuid_command: Mach.CLoadCommand {}
+
+extension Mach {
+    /// A load command containing the UUID of an image.
+    public struct UUIDCommand: LoadCommand {
+        public typealias CLoadCommandType = uuid_command
+        public let data: Data
+        public init(data: Data) { self.data = data }
+    }
+}
+
+extension Mach.UUIDCommand {
+    /// The UUID of the image.
+    public var uuid: UUID { UUID(uuid: cLoadCommand.uuid) }
+}
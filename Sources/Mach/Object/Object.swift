@@ -5,12 +5,15 @@ import MachO
 
 extension Mach {
     /// A C representation of a Mach object header.
-    public protocol CHeader: Sendable {
+    public protocol CHeader: Mach.ByteSwappable, Sendable {
         /// The magic bytes of the header.
         var magic: UInt32 { get }
 
         /// The number of load commands in the Mach object.
         var ncmds: UInt32 { get }
+
+        /// The total size of the load commands in the Mach object.
+        var sizeofcmds: UInt32 { get }
     }
 
     /// A Mach object.
@@ -87,19 +90,23 @@ extension Mach {
 }
 
 extension Mach.Object {
+    /// The raw magic value of the Mach object, in file byte order.
+    internal var rawMagic: UInt32 {
+        guard self.data.count >= MemoryLayout<UInt32>.size else { return 0 }
+        return data.withUnsafeBytes { $0.loadUnaligned(as: UInt32.self) }
+    }
+
     /// The header magic of the Mach object.
+    /// - Note: This is `nil` if the magic is not a known Mach object magic.
     public var headerMagic: Mach.HeaderMagic? {
-        Mach.HeaderMagic(rawValue: self.header.magic)
+        let rawMagic = self.rawMagic
+        return Mach.HeaderMagic.allCases.first { $0.rawValue == rawMagic }
     }
 
     /// Whether the Mach object has swapped endianess.
     public var hasSwappedEndianess: Bool {
-        switch self.headerMagic {
-        case .swapped32Bit, .swapped64Bit:
-            return true
-        default:
-            return false
-        }
+        let rawMagic = self.rawMagic
+        return rawMagic == MH_CIGAM || rawMagic == MH_CIGAM_64
     }
 }
 
@@ -108,23 +115,34 @@ extension Mach {
     public struct Object32: Mach.Object {
         public typealias CHeaderType = mach_header
         public let data: Data
-        public init(data: Data) {
-            self.data = data
-            if self.hasSwappedEndianess {
-                fatalError("Swapped endianess is not yet supported.")
-            }
-        }
+        public init(data: Data) { self.data = data }
     }
 
     /// A 64-bit Mach object.
     public struct Object64: Mach.Object {
         public typealias CHeaderType = mach_header_64
         public let data: Data
-        public init(data: Data) {
-            self.data = data
-            if self.hasSwappedEndianess {
-                fatalError("Swapped endianess is not yet supported.")
-            }
+        public init(data: Data) { self.data = data }
+    }
+}
+
+extension Mach.Object {
+    /// Initializes a Mach object from its raw data, throwing an error if the data is not a valid Mach object.
+    /// - Note: This checks the magic and that the header and load commands fit in the data.
+    public init(validating data: Data) throws {
+        self.init(data: data)
+        let headerSize = MemoryLayout<CHeaderType>.size
+        guard data.count >= headerSize else {
+            throw Mach.ObjectError.truncated(expectedSize: headerSize, actualSize: data.count)
+        }
+        let is64Bit = headerSize == MemoryLayout<mach_header_64>.size
+        let expectedMagics = is64Bit ? [MH_MAGIC_64, MH_CIGAM_64] : [MH_MAGIC, MH_CIGAM]
+        guard expectedMagics.contains(self.rawMagic) else {
+            throw Mach.ObjectError.unsupportedMagic(self.rawMagic)
+        }
+        let loadCommandsEnd = headerSize + Int(self.header.sizeofcmds)
+        guard data.count >= loadCommandsEnd else {
+            throw Mach.ObjectError.truncated(expectedSize: loadCommandsEnd, actualSize: data.count)
         }
     }
 }
@@ -142,8 +160,71 @@ extension Mach.Object {
 }
 
 extension Mach.Object {
+    /// Initializes a Mach object by memory-mapping the file at a URL.
+    /// - Note: The file is mapped rather than read, so only the pages that are accessed are brought into memory.
+    public init(contentsOf url: URL) throws {
+        try self.init(validating: try Data(contentsOf: url, options: .alwaysMapped))
+    }
+}
+
+extension Mach.Object {
+    /// The object header, in host byte order.
     public var header: CHeaderType {
-        data.withUnsafeBytes { $0.load(as: CHeaderType.self) }
+        let rawHeader = data.withUnsafeBytes { $0.loadUnaligned(as: CHeaderType.self) }
+        return self.hasSwappedEndianess ? rawHeader.byteSwapped : rawHeader
+    }
+}
+
+// MARK: - Borrowed Views
+
+extension Mach.Object {
+    /// Calls a closure with a borrowed view of the raw bytes of the object.
+    /// - Note: The bytes are in file byte order, which may be swapped.
+    /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+    public func withUnsafeBytes<ResultType>(
+        _ body: (UnsafeRawBufferPointer) throws -> ResultType
+    ) rethrows -> ResultType {
+        try data.withUnsafeBytes(body)
+    }
+
+    /// Calls a closure with a borrowed view of the raw bytes of the object header.
+    /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+    public func withUnsafeHeaderBytes<ResultType>(
+        _ body: (UnsafeRawBufferPointer) throws -> ResultType
+    ) rethrows -> ResultType {
+        try self.withUnsafeBytes { objectBytes in
+            // Objects created without validation may be shorter than their header.
+            try body(
+                UnsafeRawBufferPointer(
+                    rebasing: objectBytes[..<min(MemoryLayout<CHeaderType>.size, objectBytes.count)]
+                )
+            )
+        }
+    }
+
+    /// Calls a closure with a borrowed view of the raw bytes of the load commands in the object.
+    /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+    public func withUnsafeLoadCommandBytes<ResultType>(
+        _ body: (UnsafeRawBufferPointer) throws -> ResultType
+    ) rethrows -> ResultType {
+        let start = min(MemoryLayout<CHeaderType>.size, self.data.count)
+        let end = min(start + Int(self.header.sizeofcmds), self.data.count)
+        return try self.withUnsafeBytes { objectBytes in
+            try body(UnsafeRawBufferPointer(rebasing: objectBytes[start..<end]))
+        }
+    }
+
+    /// Calls a closure with a borrowed view of a range of the raw bytes of the object.
+    /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+    /// - Note: The range is clamped to the bounds of the object.
+    public func withUnsafeBytes<ResultType>(
+        inFileRange range: Range<Int>,
+        _ body: (UnsafeRawBufferPointer) throws -> ResultType
+    ) rethrows -> ResultType {
+        let clampedRange = range.clamped(to: 0..<self.data.count)
+        return try self.withUnsafeBytes { objectBytes in
+            try body(UnsafeRawBufferPointer(rebasing: objectBytes[clampedRange]))
+        }
     }
 }
 
@@ -166,3 +247,23 @@ extension Mach {
         }
     }
 }
+
+extension Mach {
+    /// Parses a Mach object from its raw data, throwing an error if the data is not a valid Mach object.
+    public static func object(validatingData data: Data) throws -> any Mach.Object {
+        guard data.count >= MemoryLayout<UInt32>.size else {
+            throw Mach.ObjectError.truncated(expectedSize: MemoryLayout<UInt32>.size, actualSize: data.count)
+        }
+        let machMagic = data.withUnsafeBytes { $0.loadUnaligned(as: UInt32.self) }
+        switch machMagic {
+        case MH_MAGIC, MH_CIGAM: return try Mach.Object32(validating: data)
+        case MH_MAGIC_64, MH_CIGAM_64: return try Mach.Object64(validating: data)
+        default: throw Mach.ObjectError.unsupportedMagic(machMagic)
+        }
+    }
+
+    /// Memory-maps the Mach object at a URL.
+    public static func object(contentsOf url: URL) throws -> any Mach.Object {
+        return try Mach.object(validatingData: try Data(contentsOf: url, options: .alwaysMapped))
+    }
+}
@@ -0,0 +1,27 @@
+import Foundation
+import MachCore
+
+extension Mach {
+    /// An error encountered while parsing a Mach object or fat binary.
+    public enum ObjectError: Error, CustomStringConvertible {
+        /// The magic value is not a supported Mach object or fat binary magic.
+        case unsupportedMagic(UInt32)
+
+        /// The data is smaller than its headers say it should be.
+        case truncated(expectedSize: Int, actualSize: Int)
+
+        /// An architecture in a fat binary lies outside of the fat binary's data.
+        case architectureOutOfBounds(index: Int)
+
+        public var description: String {
+            switch self {
+            case .unsupportedMagic(let magic):
+                return "Unsupported magic: " + String(format: "0x%X", magic)
+            case .truncated(let expectedSize, let actualSize):
+                return "Truncated data: expected at least \(expectedSize) bytes, found \(actualSize)"
+            case .architectureOutOfBounds(let index):
+                return "Architecture \(index) lies outside of the fat binary"
+            }
+        }
+    }
+}
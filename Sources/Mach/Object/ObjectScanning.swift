@@ -0,0 +1,123 @@
+import Foundation
+import MachCore
+import MachO
+
+extension Mach {
+    /// The result of scanning a Mach object in a batch.
+    public struct ObjectScanResult<Value: Sendable>: Sendable {
+        /// The URL of the file the object was read from, if it was read from a file.
+        public let url: URL?
+
+        /// The index of the object's architecture in its fat binary, if it is in a fat binary.
+        public let architectureIndex: Int?
+
+        /// The value produced for the object, or the error thrown while reading or scanning it.
+        public let result: Result<Value, any Error>
+    }
+}
+
+@available(macOS 10.15, iOS 13.0, *)
+extension Mach {
+    /// Scans the Mach objects in many files concurrently.
+    /// - Note: Each file is memory-mapped, and the objects in fat binaries are viewed in place rather than copied.
+    ///   At most `maximumFilesInFlight` files are mapped at once, and results are produced in completion order.
+    /// - Note: The objects in a fat binary are scanned one after another by the file's task, so that at most
+    ///   `maximumFilesInFlight` transforms run at once.
+    /// - Note: Cancelling the iteration of the returned sequence stops scanning files that have not started.
+    public static func scanObjects<Value: Sendable>(
+        at urls: [URL],
+        maximumFilesInFlight: Int = ProcessInfo.processInfo.activeProcessorCount,
+        _ transform: @escaping @Sendable (any Mach.Object) throws -> Value
+    ) -> AsyncStream<ObjectScanResult<Value>> {
+        AsyncStream { continuation in
+            let scanningTask = Task {
+                await withTaskGroup(of: Void.self) { group in
+                    var remainingURLs = urls.makeIterator()
+                    for _ in 0..<max(1, maximumFilesInFlight) {
+                        guard let url = remainingURLs.next() else { break }
+                        group.addTask { await Self.scanFile(at: url, transform, into: continuation) }
+                    }
+                    // Start the next file as each one finishes, so that the number of mapped files stays bounded.
+                    while await group.next() != nil {
+                        guard !Task.isCancelled, let url = remainingURLs.next() else { continue }
+                        group.addTask { await Self.scanFile(at: url, transform, into: continuation) }
+                    }
+                }
+                continuation.finish()
+            }
+            continuation.onTermination = { _ in scanningTask.cancel() }
+        }
+    }
+
+    /// Scans the objects in a fat binary concurrently.
+    /// - Note: The objects are viewed in place rather than copied, and results are produced in completion order.
+    public static func scanObjects<Value: Sendable>(
+        in fatBinary: some Mach.FatBinary,
+        _ transform: @escaping @Sendable (any Mach.Object) throws -> Value
+    ) -> AsyncStream<ObjectScanResult<Value>> {
+        AsyncStream { continuation in
+            let scanningTask = Task {
+                await Self.scanArchitectures(
+                    of: fatBinary, url: nil, concurrently: true, transform, into: continuation
+                )
+                continuation.finish()
+            }
+            continuation.onTermination = { _ in scanningTask.cancel() }
+        }
+    }
+
+    /// Scans the objects in a file, which may be a fat binary.
+    private static func scanFile<Value: Sendable>(
+        at url: URL,
+        _ transform: @escaping @Sendable (any Mach.Object) throws -> Value,
+        into continuation: AsyncStream<ObjectScanResult<Value>>.Continuation
+    ) async {
+        guard !Task.isCancelled else { return }
+        let data: Data
+        do {
+            data = try Data(contentsOf: url, options: .alwaysMapped)
+        } catch {
+            continuation.yield(ObjectScanResult(url: url, architectureIndex: nil, result: .failure(error)))
+            return
+        }
+        let magic: UInt32? =
+            data.count >= MemoryLayout<UInt32>.size
+            ? data.withUnsafeBytes { $0.loadUnaligned(as: UInt32.self) } : nil
+        switch magic {
+        case FAT_MAGIC, FAT_CIGAM, FAT_MAGIC_64, FAT_CIGAM_64:
+            do {
+                let fatBinary = try Mach.fatBinary(validatingData: data)
+                await Self.scanArchitectures(
+                    of: fatBinary, url: url, concurrently: false, transform, into: continuation
+                )
+            } catch {
+                continuation.yield(ObjectScanResult(url: url, architectureIndex: nil, result: .failure(error)))
+            }
+        default:
+            let result = Result { try transform(try Mach.object(validatingData: data)) }
+            continuation.yield(ObjectScanResult(url: url, architectureIndex: nil, result: result))
+        }
+    }
+
+    /// Scans the objects in a fat binary, either concurrently or one after another.
+    private static func scanArchitectures<Value: Sendable>(
+        of fatBinary: some Mach.FatBinary, url: URL?, concurrently: Bool,
+        _ transform: @escaping @Sendable (any Mach.Object) throws -> Value,
+        into continuation: AsyncStream<ObjectScanResult<Value>>.Continuation
+    ) async {
+        let scanArchitecture = { @Sendable (index: Int, architecture: Mach.FatArchitecture) in
+            guard !Task.isCancelled else { return }
+            let result = Result { try transform(try architecture.validatedObject(withFatBinary: fatBinary)) }
+            continuation.yield(ObjectScanResult(url: url, architectureIndex: index, result: result))
+        }
+        guard concurrently else {
+            for (index, architecture) in fatBinary.architectures.enumerated() { scanArchitecture(index, architecture) }
+            return
+        }
+        await withTaskGroup(of: Void.self) { group in
+            for (index, architecture) in fatBinary.architectures.enumerated() {
+                group.addTask { scanArchitecture(index, architecture) }
+            }
+        }
+    }
+}
@@ -0,0 +1,24 @@
+import Foundation
+import MachCore
+
+extension Mach {
+    /// A version number packed into 32 bits as `xxxx.yy.zz`.
+    public struct PackedVersion: RawRepresentable, Hashable, Sendable, CustomStringConvertible {
+        /// The raw packed version.
+        public let rawValue: UInt32
+
+        /// Represents a packed version.
+        public init(rawValue: UInt32) { self.rawValue = rawValue }
+
+        /// The major version.
+        public var major: UInt32 { rawValue >> 16 }
+
+        /// The minor version.
+        public var minor: UInt32 { (rawValue >> 8) & 0xFF }
+
+        /// The patch version.
+        public var patch: UInt32 { rawValue & 0xFF }
+
+        public var description: String { "\(major).\(minor).\(patch)" }
+    }
+}
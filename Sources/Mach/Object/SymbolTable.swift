@@ -0,0 +1,226 @@
+import Foundation
+import MachCore
+import MachO
+
+extension Mach {
+    /// An index of the defined symbols in a 64-bit Mach object.
+    /// - Note: The index is built once and can be reused for any number of lookups. Lookups do not allocate.
+    public struct SymbolTable: Sendable {
+        /// A symbol in a symbol table.
+        public struct Symbol: Hashable, Sendable {
+            /// The index of the symbol in the object's symbol table.
+            public let index: UInt32
+
+            /// The address of the symbol.
+            public let address: UInt64
+
+            /// The type flags of the symbol.
+            public let type: UInt8
+
+            /// The number of the section the symbol is in.
+            public let sectionNumber: UInt8
+
+            /// The description flags of the symbol.
+            public let descriptionFlags: UInt16
+
+            /// The offset of the symbol name in the string table.
+            internal let nameOffset: UInt32
+
+            /// Whether the symbol is external.
+            public var isExternal: Bool { type & UInt8(N_EXT) != 0 }
+        }
+
+        /// The raw data of the object the symbols were read from.
+        private let data: Data
+
+        /// The range of the string table in the object's data.
+        private let stringTableRange: Range<Int>
+
+        /// The symbols, sorted by address.
+        public let symbols: [Symbol]
+
+        /// The addresses of the symbols, in the same order as ``symbols``.
+        /// - Note: This is kept separately so that binary searches only touch the addresses.
+        private let addresses: [UInt64]
+
+        /// The open-addressed hash buckets for name lookups, containing indices into ``symbols`` (or -1 if empty).
+        private let nameBuckets: [Int32]
+
+        /// The hashes of the names of the symbols in each bucket.
+        private let nameBucketHashes: [UInt32]
+
+        /// Builds a symbol table index for a 64-bit Mach object.
+        /// - Note: Returns `nil` if the object has no symbol table.
+        public init?(object: Mach.Object64) {
+            guard let symbolTableCommand = object.loadCommands(ofType: Mach.SymbolTableCommand.self).first
+            else { return nil }
+            let dynamicSymbolTableCommand =
+                object.loadCommands(ofType: Mach.DynamicSymbolTableCommand.self).first
+
+            self.data = object.data
+            let stringTableStart = Int(symbolTableCommand.stringTableOffset)
+            self.stringTableRange =
+                (stringTableStart..<stringTableStart + Int(symbolTableCommand.stringTableSize))
+                .clamped(to: 0..<object.data.count)
+
+            // Only the local and externally-defined symbols can have addresses, so skip the rest if we can.
+            let symbolCount = symbolTableCommand.numberOfSymbols
+            let candidateRanges: [Range<UInt32>] =
+                if let dynamicSymbolTableCommand {
+                    [
+                        dynamicSymbolTableCommand.localSymbolIndices,
+                        dynamicSymbolTableCommand.externallyDefinedSymbolIndices,
+                    ].map { $0.clamped(to: 0..<symbolCount) }
+                } else { [0..<symbolCount] }
+
+            // Read the symbols with a reader specialized for the object's byte order.
+            let symbolTableOffset = Int(symbolTableCommand.symbolTableOffset)
+            var symbols =
+                object.hasSwappedEndianess
+                ? Self.readSymbols(
+                    byteOrder: Mach.SwappedByteOrder.self, from: object, at: symbolTableOffset,
+                    indices: candidateRanges.joined(), stringTableSize: self.stringTableRange.count
+                )
+                : Self.readSymbols(
+                    byteOrder: Mach.HostByteOrder.self, from: object, at: symbolTableOffset,
+                    indices: candidateRanges.joined(), stringTableSize: self.stringTableRange.count
+                )
+            symbols.sort { ($0.address, $0.index) < ($1.address, $1.index) }
+            self.symbols = symbols
+            self.addresses = symbols.map(\.address)
+
+            // Build the name index with a load factor of at most one half.
+            var bucketCount = 1
+            while bucketCount < symbols.count * 2 { bucketCount <<= 1 }
+            var nameBuckets = [Int32](repeating: -1, count: bucketCount)
+            var nameBucketHashes = [UInt32](repeating: 0, count: bucketCount)
+            let stringTableRange = self.stringTableRange
+            object.data.withUnsafeBytes { objectBytes in
+                let stringTable = UnsafeRawBufferPointer(rebasing: objectBytes[stringTableRange])
+                for (symbolIndex, symbol) in symbols.enumerated() {
+                    let hash = Self.hash(Self.nameBytes(of: symbol, in: stringTable))
+                    var bucket = Int(hash) & (bucketCount - 1)
+                    while nameBuckets[bucket] != -1 { bucket = (bucket + 1) & (bucketCount - 1) }
+                    nameBuckets[bucket] = Int32(symbolIndex)
+                    nameBucketHashes[bucket] = hash
+                }
+            }
+            self.nameBuckets = nameBuckets
+            self.nameBucketHashes = nameBucketHashes
+        }
+
+        /// Reads the defined symbols at a set of indices in a symbol table.
+        private static func readSymbols<ByteOrder: Mach.ByteOrder>(
+            byteOrder: ByteOrder.Type, from object: Mach.Object64, at symbolTableOffset: Int,
+            indices: some Sequence<UInt32>, stringTableSize: Int
+        ) -> [Symbol] {
+            var symbols: [Symbol] = []
+            object.withUnsafeBytes { objectBytes in
+                for index in indices {
+                    let entryOffset = symbolTableOffset + Int(index) * MemoryLayout<nlist_64>.size
+                    guard entryOffset + MemoryLayout<nlist_64>.size <= objectBytes.count else { break }
+                    let entry = ByteOrder.toHost(
+                        objectBytes.loadUnaligned(fromByteOffset: entryOffset, as: nlist_64.self)
+                    )
+                    // Skip debugging symbols and symbols that are not defined in a section.
+                    guard entry.n_type & UInt8(N_STAB) == 0,
+                        entry.n_type & UInt8(N_TYPE) == UInt8(N_SECT),
+                        Int(entry.n_un.n_strx) < stringTableSize
+                    else { continue }
+                    symbols.append(
+                        Symbol(
+                            index: index, address: entry.n_value, type: entry.n_type,
+                            sectionNumber: entry.n_sect, descriptionFlags: entry.n_desc,
+                            nameOffset: entry.n_un.n_strx
+                        )
+                    )
+                }
+            }
+            return symbols
+        }
+
+        /// Hashes a name using 32-bit FNV-1a.
+        private static func hash(_ bytes: UnsafeRawBufferPointer) -> UInt32 {
+            var hash: UInt32 = 0x811C_9DC5
+            for byte in bytes {
+                hash ^= UInt32(byte)
+                hash &*= 0x0100_0193
+            }
+            return hash
+        }
+
+        /// Gets the bytes of the name of a symbol, without the null terminator.
+        private static func nameBytes(
+            of symbol: Symbol, in stringTable: UnsafeRawBufferPointer
+        ) -> UnsafeRawBufferPointer {
+            let start = Int(symbol.nameOffset)
+            var end = start
+            while end < stringTable.count && stringTable[end] != 0 { end += 1 }
+            return UnsafeRawBufferPointer(rebasing: stringTable[start..<end])
+        }
+    }
+}
+
+extension Mach.SymbolTable {
+    /// Gets the symbol with the greatest address less than or equal to an address.
+    /// - Note: The address must be in the object's address space (that is, without any slide applied).
+    public func symbol(nearestTo address: UInt64) -> Symbol? {
+        // Find the first symbol with an address greater than the given address.
+        var low = 0
+        var high = self.addresses.count
+        while low < high {
+            let middle = (low + high) / 2
+            if self.addresses[middle] <= address { low = middle + 1 } else { high = middle }
+        }
+        guard low > 0 else { return nil }
+        return self.symbols[low - 1]
+    }
+
+    /// Gets the symbol with a given name.
+    public func symbol(named name: String) -> Symbol? {
+        var name = name
+        return name.withUTF8 { self.symbol(named: UnsafeRawBufferPointer($0)) }
+    }
+
+    /// Gets the symbol with a given name, expressed as raw UTF-8 bytes.
+    public func symbol(named nameBytes: UnsafeRawBufferPointer) -> Symbol? {
+        guard !self.symbols.isEmpty else { return nil }
+        let hash = Self.hash(nameBytes)
+        let bucketMask = self.nameBuckets.count - 1
+        return self.withUnsafeStringTable { stringTable in
+            var bucket = Int(hash) & bucketMask
+            while self.nameBuckets[bucket] != -1 {
+                let symbol = self.symbols[Int(self.nameBuckets[bucket])]
+                if self.nameBucketHashes[bucket] == hash,
+                    Self.nameBytes(of: symbol, in: stringTable).elementsEqual(nameBytes)
+                {
+                    return symbol
+                }
+                bucket = (bucket + 1) & bucketMask
+            }
+            return nil
+        }
+    }
+
+    /// Gets the name of a symbol.
+    public func name(of symbol: Symbol) -> String {
+        self.withUnsafeNameBytes(of: symbol) { String(decoding: $0, as: UTF8.self) }
+    }
+
+    /// Calls a closure with a borrowed view of the raw UTF-8 bytes of the name of a symbol.
+    /// - Warning: The buffer pointer is only valid for the duration of the closure and must not escape it.
+    public func withUnsafeNameBytes<ResultType>(
+        of symbol: Symbol, _ body: (UnsafeRawBufferPointer) throws -> ResultType
+    ) rethrows -> ResultType {
+        try self.withUnsafeStringTable { try body(Self.nameBytes(of: symbol, in: $0)) }
+    }
+
+    /// Calls a closure with a borrowed view of the string table.
+    private func withUnsafeStringTable<ResultType>(
+        _ body: (UnsafeRawBufferPointer) throws -> ResultType
+    ) rethrows -> ResultType {
+        try self.data.withUnsafeBytes {
+            try body(UnsafeRawBufferPointer(rebasing: $0[self.stringTableRange]))
+        }
+    }
+}
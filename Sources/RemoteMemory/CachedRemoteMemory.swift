@@ -0,0 +1,238 @@
+import Foundation
+
+// MARK: - Remote Memory Source
+
+/// A source of memory from another address space.
+/// - Note: This abstracts over the address space being read, so that ``CachedRemoteMemory`` can be layered over any
+///   source, including a mock source in tests.
+public protocol RemoteMemorySource {
+    /// Reads exactly enough bytes to fill a buffer, starting at an address.
+    func read(from address: UInt64, into buffer: UnsafeMutableRawBufferPointer) throws
+}
+
+// MARK: - Cached Remote Memory
+
+/// A least-recently-used cache of page-sized chunks of memory from another address space.
+/// - Note: When pages are missed in sequence, the following pages are prefetched in the same read.
+/// - Important: The cache does not observe the source, so it must be invalidated whenever the memory may have
+///   changed (such as after resuming the task being read).
+/// - Warning: The cache is not thread-safe, as even reads update its recency list. Each thread must use its own cache,
+///   or the caller must serialize access to a shared one.
+public final class CachedRemoteMemory<Source: RemoteMemorySource>: RemoteMemorySource {
+    /// The source of the memory.
+    public let source: Source
+
+    /// The size of each cached chunk.
+    public let pageSize: Int
+
+    /// The maximum number of pages held by the cache.
+    public let capacity: Int
+
+    /// The number of pages prefetched after a page that is missed directly after the previous missed page.
+    public let prefetchPageCount: Int
+
+    /// The number of page lookups that were served from the cache.
+    public private(set) var hitCount = 0
+
+    /// The number of page lookups that had to read from the source.
+    public private(set) var missCount = 0
+
+    /// The storage for the cached pages, with one page-sized slot for each page.
+    private let storage: UnsafeMutableRawPointer
+
+    /// The storage that pages are read into before being copied into their slots.
+    private let readBuffer: UnsafeMutableRawPointer
+
+    /// The slots of the cached pages, keyed by page number.
+    private var slotsByPage: [UInt64: Int] = [:]
+
+    /// The page number held in each used slot.
+    private var pageInSlot: [UInt64]
+
+    /// The more recently used neighbor of each used slot, or -1 if there is none.
+    private var previousSlot: [Int]
+
+    /// The less recently used neighbor of each used slot, or -1 if there is none.
+    private var nextSlot: [Int]
+
+    /// The most recently used slot, or -1 if the cache is empty.
+    private var mostRecentSlot = -1
+
+    /// The least recently used slot, or -1 if the cache is empty.
+    private var leastRecentSlot = -1
+
+    /// The page number of the last missed page.
+    private var lastMissedPage: UInt64?
+
+    /// Creates a cache over a source of memory.
+    public init(
+        source: Source, pageSize: Int = NSPageSize(), capacity: Int = 256, prefetchPageCount: Int = 4
+    ) {
+        precondition(pageSize > 0 && pageSize & (pageSize - 1) == 0, "The page size must be a power of two.")
+        precondition(capacity > 0, "The capacity must be positive.")
+        self.source = source
+        self.pageSize = pageSize
+        self.capacity = capacity
+        self.prefetchPageCount = min(max(prefetchPageCount, 0), capacity - 1)
+        self.storage = UnsafeMutableRawPointer.allocate(byteCount: capacity * pageSize, alignment: pageSize)
+        self.readBuffer = UnsafeMutableRawPointer.allocate(
+            byteCount: (self.prefetchPageCount + 1) * pageSize, alignment: pageSize
+        )
+        self.pageInSlot = []
+        self.previousSlot = []
+        self.nextSlot = []
+        self.pageInSlot.reserveCapacity(capacity)
+        self.previousSlot.reserveCapacity(capacity)
+        self.nextSlot.reserveCapacity(capacity)
+    }
+
+    deinit {
+        self.storage.deallocate()
+        self.readBuffer.deallocate()
+    }
+
+    /// Removes a used slot from the recency list.
+    private func unlink(_ slot: Int) {
+        let previous = self.previousSlot[slot]
+        let next = self.nextSlot[slot]
+        if previous != -1 { self.nextSlot[previous] = next } else { self.mostRecentSlot = next }
+        if next != -1 { self.previousSlot[next] = previous } else { self.leastRecentSlot = previous }
+    }
+
+    /// Inserts a used slot at the most recent end of the recency list.
+    private func linkAsMostRecent(_ slot: Int) {
+        self.previousSlot[slot] = -1
+        self.nextSlot[slot] = self.mostRecentSlot
+        if self.mostRecentSlot != -1 { self.previousSlot[self.mostRecentSlot] = slot }
+        self.mostRecentSlot = slot
+        if self.leastRecentSlot == -1 { self.leastRecentSlot = slot }
+    }
+
+    /// Gets a slot for a new page, evicting the least recently used page if the cache is full.
+    private func claimSlot(for page: UInt64) -> Int {
+        let slot: Int
+        if self.pageInSlot.count < self.capacity {
+            slot = self.pageInSlot.count
+            self.pageInSlot.append(page)
+            self.previousSlot.append(-1)
+            self.nextSlot.append(-1)
+        } else {
+            slot = self.leastRecentSlot
+            self.unlink(slot)
+            self.slotsByPage.removeValue(forKey: self.pageInSlot[slot])
+            self.pageInSlot[slot] = page
+        }
+        self.slotsByPage[page] = slot
+        self.linkAsMostRecent(slot)
+        return slot
+    }
+
+    /// Reads a page from the source, prefetching the following pages if the page is missed in sequence.
+    /// - Returns: The slot of the page.
+    private func loadPage(_ page: UInt64) throws -> Int {
+        let isSequential = self.lastMissedPage.map { $0 &+ 1 == page } ?? false
+        let pageAddress = page &* UInt64(self.pageSize)
+        var pageCount = 1
+        if isSequential && self.prefetchPageCount > 0 {
+            let prefetchCount = self.prefetchPageCount + 1
+            // The pages after the missed page may not be readable, in which case we only read the missed page.
+            if (try? self.source.read(
+                from: pageAddress,
+                into: UnsafeMutableRawBufferPointer(start: self.readBuffer, count: prefetchCount * self.pageSize)
+            )) != nil {
+                pageCount = prefetchCount
+            }
+        }
+        if pageCount == 1 {
+            try self.source.read(
+                from: pageAddress,
+                into: UnsafeMutableRawBufferPointer(start: self.readBuffer, count: self.pageSize)
+            )
+        }
+        self.lastMissedPage = page &+ UInt64(pageCount - 1)
+
+        // Insert the prefetched pages first, so that the missed page ends up as the most recently used.
+        for pageOffset in (0..<pageCount).reversed() {
+            let prefetchedPage = page &+ UInt64(pageOffset)
+            let slot = self.slotsByPage[prefetchedPage] ?? self.claimSlot(for: prefetchedPage)
+            (self.storage + slot * self.pageSize).copyMemory(
+                from: self.readBuffer + pageOffset * self.pageSize, byteCount: self.pageSize
+            )
+        }
+        return self.slotsByPage[page]!
+    }
+
+    /// Gets the slot of a page, reading it from the source if it is not cached.
+    private func slot(for page: UInt64) throws -> Int {
+        if let slot = self.slotsByPage[page] {
+            self.hitCount += 1
+            if slot != self.mostRecentSlot {
+                self.unlink(slot)
+                self.linkAsMostRecent(slot)
+            }
+            return slot
+        }
+        self.missCount += 1
+        return try self.loadPage(page)
+    }
+
+    /// Reads exactly enough bytes to fill a buffer, starting at an address, using cached pages where possible.
+    public func read(from address: UInt64, into buffer: UnsafeMutableRawBufferPointer) throws {
+        let pageSize = UInt64(self.pageSize)
+        var copiedCount = 0
+        while copiedCount < buffer.count {
+            let currentAddress = address &+ UInt64(copiedCount)
+            let offsetInPage = Int(currentAddress & (pageSize - 1))
+            let slot = try self.slot(for: currentAddress / pageSize)
+            let chunkSize = min(self.pageSize - offsetInPage, buffer.count - copiedCount)
+            (buffer.baseAddress! + copiedCount).copyMemory(
+                from: self.storage + slot * self.pageSize + offsetInPage, byteCount: chunkSize
+            )
+            copiedCount += chunkSize
+        }
+    }
+
+    /// Reads a value at an address, using cached pages where possible.
+    public func read<T: BitwiseCopyable>(_ type: T.Type = T.self, from address: UInt64) throws -> T {
+        try withUnsafeTemporaryAllocation(
+            byteCount: MemoryLayout<T>.size, alignment: MemoryLayout<T>.alignment
+        ) { valueBytes in
+            try self.read(from: address, into: valueBytes)
+            return valueBytes.loadUnaligned(as: T.self)
+        }
+    }
+
+    /// Removes all pages from the cache.
+    public func invalidate() {
+        self.slotsByPage.removeAll(keepingCapacity: true)
+        self.pageInSlot.removeAll(keepingCapacity: true)
+        self.previousSlot.removeAll(keepingCapacity: true)
+        self.nextSlot.removeAll(keepingCapacity: true)
+        self.mostRecentSlot = -1
+        self.leastRecentSlot = -1
+        self.lastMissedPage = nil
+    }
+
+    /// Removes the pages overlapping an address range from the cache.
+    /// - Note: The slots of the removed pages are only reused once the cache is full.
+    public func invalidate(_ range: Range<UInt64>) {
+        guard !range.isEmpty else { return }
+        let pageSize = UInt64(self.pageSize)
+        let pages = (range.lowerBound / pageSize)...((range.upperBound - 1) / pageSize)
+        // Walk whichever is smaller: the pages in the range, or the cached pages.
+        let invalidatedPages =
+            pages.count > self.slotsByPage.count
+            ? self.slotsByPage.keys.filter { pages.contains($0) } : pages.filter { self.slotsByPage[$0] != nil }
+        for page in invalidatedPages {
+            let slot = self.slotsByPage.removeValue(forKey: page)!
+            // Move the slot to the least recently used end, so that it is reused first.
+            self.unlink(slot)
+            self.previousSlot[slot] = self.leastRecentSlot
+            self.nextSlot[slot] = -1
+            if self.leastRecentSlot != -1 { self.nextSlot[self.leastRecentSlot] = slot }
+            self.leastRecentSlot = slot
+            if self.mostRecentSlot == -1 { self.mostRecentSlot = slot }
+            self.pageInSlot[slot] = UInt64.max
+        }
+    }
+}
@@ -0,0 +1,153 @@
+import RemoteMemory
+import XCTest
+
+/// A source of memory whose bytes are derived from their addresses, recording every read.
+private final class MockMemorySource: RemoteMemorySource {
+    /// An error for reads past the end of the source.
+    struct OutOfBoundsError: Error {}
+
+    /// The end of the readable memory.
+    let endAddress: UInt64
+
+    /// A value mixed into every byte, changed to simulate the memory being written.
+    var generation: UInt8 = 0
+
+    /// The address ranges read, in order.
+    private(set) var reads: [Range<UInt64>] = []
+
+    init(endAddress: UInt64) {
+        self.endAddress = endAddress
+    }
+
+    /// The byte at an address.
+    func byte(at address: UInt64) -> UInt8 {
+        UInt8(truncatingIfNeeded: address &* 31 &+ address >> 8) ^ self.generation
+    }
+
+    func read(from address: UInt64, into buffer: UnsafeMutableRawBufferPointer) throws {
+        let range = address..<address + UInt64(buffer.count)
+        guard range.upperBound <= self.endAddress else { throw OutOfBoundsError() }
+        self.reads.append(range)
+        for (offset, address) in range.enumerated() { buffer[offset] = self.byte(at: address) }
+    }
+}
+
+final class CachedRemoteMemoryTests: XCTestCase {
+    private let pageSize = 64
+
+    /// Reads bytes through a cache.
+    private func bytes(
+        from cache: CachedRemoteMemory<MockMemorySource>, at address: UInt64, count: Int
+    ) throws -> [UInt8] {
+        var bytes = [UInt8](repeating: 0, count: count)
+        try bytes.withUnsafeMutableBytes { try cache.read(from: address, into: $0) }
+        return bytes
+    }
+
+    /// The bytes the source holds at an address.
+    private func expectedBytes(from source: MockMemorySource, at address: UInt64, count: Int) -> [UInt8] {
+        (address..<address + UInt64(count)).map { source.byte(at: $0) }
+    }
+
+    func testReadsSpanningPagesMatchTheSource() throws {
+        let source = MockMemorySource(endAddress: 64 * 64)
+        let cache = CachedRemoteMemory(source: source, pageSize: self.pageSize, capacity: 4, prefetchPageCount: 0)
+        for (address, count) in [(0, 1), (10, 100), (63, 2), (200, 300), (1000, 64)] as [(UInt64, Int)] {
+            XCTAssertEqual(
+                try self.bytes(from: cache, at: address, count: count),
+                self.expectedBytes(from: source, at: address, count: count)
+            )
+        }
+        let expectedValue = self.expectedBytes(from: source, at: 130, count: 4).withUnsafeBytes {
+            $0.loadUnaligned(as: UInt32.self)
+        }
+        XCTAssertEqual(try cache.read(UInt32.self, from: 130), expectedValue)
+    }
+
+    func testEvictsTheLeastRecentlyUsedPage() throws {
+        let source = MockMemorySource(endAddress: 64 * 64)
+        let cache = CachedRemoteMemory(source: source, pageSize: self.pageSize, capacity: 2, prefetchPageCount: 0)
+        _ = try self.bytes(from: cache, at: 0, count: 1)  // Miss page 0.
+        _ = try self.bytes(from: cache, at: 128, count: 1)  // Miss page 2.
+        _ = try self.bytes(from: cache, at: 0, count: 1)  // Hit page 0, making page 2 the least recently used.
+        _ = try self.bytes(from: cache, at: 256, count: 1)  // Miss page 4, evicting page 2.
+        XCTAssertEqual(cache.hitCount, 1)
+        XCTAssertEqual(cache.missCount, 3)
+
+        _ = try self.bytes(from: cache, at: 0, count: 1)  // Page 0 is still cached.
+        XCTAssertEqual(cache.hitCount, 2)
+        _ = try self.bytes(from: cache, at: 128, count: 1)  // Page 2 was evicted.
+        XCTAssertEqual(cache.missCount, 4)
+        XCTAssertEqual(source.reads, [0..<64, 128..<192, 256..<320, 128..<192])
+    }
+
+    func testPrefetchesAfterSequentialMisses() throws {
+        let source = MockMemorySource(endAddress: 64 * 64)
+        let cache = CachedRemoteMemory(source: source, pageSize: self.pageSize, capacity: 8, prefetchPageCount: 2)
+        _ = try self.bytes(from: cache, at: 0, count: 1)  // Miss page 0 on its own.
+        _ = try self.bytes(from: cache, at: 64, count: 1)  // Miss page 1 in sequence, prefetching pages 2 and 3.
+        XCTAssertEqual(source.reads, [0..<64, 64..<256])
+
+        XCTAssertEqual(
+            try self.bytes(from: cache, at: 128, count: 128), self.expectedBytes(from: source, at: 128, count: 128)
+        )
+        XCTAssertEqual(source.reads.count, 2)
+        XCTAssertEqual(cache.hitCount, 2)
+        XCTAssertEqual(cache.missCount, 2)
+    }
+
+    func testPrefetchFallsBackToTheMissedPageAtTheEndOfTheSource() throws {
+        let source = MockMemorySource(endAddress: 3 * 64)
+        let cache = CachedRemoteMemory(source: source, pageSize: self.pageSize, capacity: 8, prefetchPageCount: 4)
+        _ = try self.bytes(from: cache, at: 64, count: 1)
+        // Prefetching past page 2 fails, so only the missed page is read.
+        XCTAssertEqual(
+            try self.bytes(from: cache, at: 128, count: 64), self.expectedBytes(from: source, at: 128, count: 64)
+        )
+        XCTAssertEqual(source.reads, [64..<128, 128..<192])
+        XCTAssertThrowsError(try self.bytes(from: cache, at: 192, count: 1))
+    }
+
+    func testInvalidatingARangeOnlyRemovesOverlappingPages() throws {
+        let source = MockMemorySource(endAddress: 64 * 64)
+        let cache = CachedRemoteMemory(source: source, pageSize: self.pageSize, capacity: 4, prefetchPageCount: 0)
+        let originalBytes = try self.bytes(from: cache, at: 0, count: 3 * 64)
+        source.generation = 0xFF
+
+        cache.invalidate(70..<80)
+        XCTAssertEqual(try self.bytes(from: cache, at: 0, count: 64), Array(originalBytes[0..<64]))
+        XCTAssertEqual(
+            try self.bytes(from: cache, at: 64, count: 64), self.expectedBytes(from: source, at: 64, count: 64)
+        )
+        XCTAssertEqual(try self.bytes(from: cache, at: 128, count: 64), Array(originalBytes[128..<192]))
+        XCTAssertEqual(cache.missCount, 4)
+
+        cache.invalidate(0..<0)
+        XCTAssertEqual(cache.missCount, 4)
+    }
+
+    func testInvalidatedSlotsAreReusedFirst() throws {
+        let source = MockMemorySource(endAddress: 64 * 64)
+        let cache = CachedRemoteMemory(source: source, pageSize: self.pageSize, capacity: 2, prefetchPageCount: 0)
+        _ = try self.bytes(from: cache, at: 0, count: 1)
+        _ = try self.bytes(from: cache, at: 128, count: 1)
+        // Page 2 is the most recently used, but invalidating it makes its slot the next to be reused.
+        cache.invalidate(128..<129)
+        _ = try self.bytes(from: cache, at: 256, count: 1)
+        _ = try self.bytes(from: cache, at: 0, count: 1)
+        XCTAssertEqual(cache.hitCount, 1)
+        XCTAssertEqual(source.reads, [0..<64, 128..<192, 256..<320])
+    }
+
+    func testInvalidatingEverythingRereadsFromTheSource() throws {
+        let source = MockMemorySource(endAddress: 64 * 64)
+        let cache = CachedRemoteMemory(source: source, pageSize: self.pageSize, capacity: 4, prefetchPageCount: 2)
+        _ = try self.bytes(from: cache, at: 0, count: 128)
+        source.generation = 0x5A
+        cache.invalidate()
+        XCTAssertEqual(
+            try self.bytes(from: cache, at: 0, count: 128), self.expectedBytes(from: source, at: 0, count: 128)
+        )
+        XCTAssertEqual(source.reads.count, 4)
+    }
+}